@@ -0,0 +1,573 @@
+#include "uuid-cpp/uuid.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace uuid;
+
+// number of distinct samples cycled through by each benchmark,
+// small enough to stay in cache so the kernels dominate the timings
+constexpr std::size_t SAMPLES = 1024;
+
+static const std::vector<Uuid>& _uuids()
+{
+    static const auto bag = [] {
+        RandomEngine      gen{};
+        std::vector<Uuid> v(SAMPLES);
+        std::generate(std::begin(v), std::end(v), std::ref(gen));
+        return v;
+    }();
+    return bag;
+}
+
+template <typename Encoder>
+static std::vector<std::string> _strings(Encoder encode)
+{
+    std::vector<std::string> v;
+    v.reserve(SAMPLES);
+    for (const auto& u : _uuids())
+        v.push_back(encode(u));
+    return v;
+}
+
+
+
+// parsing /////////////////////////////////////////////////////////////////
+
+static void BM_Parse(benchmark::State& state)
+{
+    const auto  text = _strings([](const Uuid& u) { return u.string(); });
+    std::size_t i    = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(parse(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Parse);
+
+static void BM_TryParse(benchmark::State& state)
+{
+    const auto  text = _strings([](const Uuid& u) { return u.string(); });
+    std::size_t i    = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(try_parse(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TryParse);
+
+static void BM_TryParseInvalid(benchmark::State& state)
+{ // rejection path, last digit is not hexadecimal
+    auto text = _strings([](const Uuid& u) { return u.string(); });
+    for (auto& s : text)
+        s.back() = 'z';
+
+    std::size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(try_parse(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TryParseInvalid);
+
+static void BM_ParseBase64(benchmark::State& state)
+{
+    const auto  text = _strings([](const Uuid& u) { return to_base64(u); });
+    std::size_t i    = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(try_parse_base64(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseBase64);
+
+static void BM_ParseBase32(benchmark::State& state)
+{
+    const auto  text = _strings([](const Uuid& u) { return to_base32(u); });
+    std::size_t i    = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(try_parse_base32(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseBase32);
+
+static void BM_ParseBase58(benchmark::State& state)
+{
+    const auto  text = _strings([](const Uuid& u) { return to_base58(u); });
+    std::size_t i    = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(try_parse_base58(text[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseBase58);
+
+
+
+// formatting //////////////////////////////////////////////////////////////
+
+static void BM_String(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    std::size_t i   = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(bag[i++ % SAMPLES].string());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_String);
+
+static void BM_ToBase64(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    char        buffer[UUID_BASE64_STRING_SIZE];
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        to_base64(bag[i++ % SAMPLES], buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ToBase64);
+
+static void BM_ToBase32(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    char        buffer[UUID_BASE32_STRING_SIZE];
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        to_base32(bag[i++ % SAMPLES], buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ToBase32);
+
+static void BM_ToBase58(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    char        buffer[UUID_BASE58_STRING_SIZE];
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        to_base58(bag[i++ % SAMPLES], buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ToBase58);
+
+
+
+// comparisons and hashing /////////////////////////////////////////////////
+
+static void BM_Equal(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    std::size_t i   = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bag[i % SAMPLES] == bag[(i + 1) % SAMPLES]);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Equal);
+
+static void BM_Less(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    std::size_t i   = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bag[i % SAMPLES] < bag[(i + 1) % SAMPLES]);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Less);
+
+static void BM_Sort(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto copy = bag;
+        state.ResumeTiming();
+        std::sort(std::begin(copy), std::end(copy));
+        benchmark::DoNotOptimize(std::data(copy));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(BM_Sort);
+
+static void BM_SortSqlServer(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto copy = bag;
+        state.ResumeTiming();
+        std::sort(std::begin(copy), std::end(copy), SqlServerLess{});
+        benchmark::DoNotOptimize(std::data(copy));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(BM_SortSqlServer);
+
+static void BM_SwapGuidOrder(benchmark::State& state)
+{
+    auto bag = _uuids();
+    for (auto _ : state)
+    {
+        swap_guid_order(bag);
+        benchmark::DoNotOptimize(std::data(bag));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(BM_SwapGuidOrder);
+
+static void BM_Hash(benchmark::State& state)
+{
+    const auto&           bag = _uuids();
+    const std::hash<Uuid> hasher{};
+    std::size_t           i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(hasher(bag[i++ % SAMPLES]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Hash);
+
+
+
+// filters /////////////////////////////////////////////////////////////////
+
+template <typename F>
+static void BM_FilterContainsMany(benchmark::State& state)
+{ // filter over a large set, queried with UUIDs that are mostly absent
+    static const auto filter = [] {
+        RandomEngine      gen{};
+        std::vector<Uuid> members(1 << 22);
+        std::generate(std::begin(members), std::end(members), std::ref(gen));
+        return F{ members };
+    }();
+
+    const auto& bag  = _uuids();
+    auto        hits = std::make_unique<bool[]>(SAMPLES);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(filter.contains_many(bag, { hits.get(), SAMPLES }));
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK_TEMPLATE(BM_FilterContainsMany, BloomFilter);
+BENCHMARK_TEMPLATE(BM_FilterContainsMany, XorFilter);
+
+
+
+
+// sharding ////////////////////////////////////////////////////////////////
+
+constexpr std::uint32_t SHARDS = 1024;
+
+static void BM_ShardString(benchmark::State& state)
+{ // the usual approach, hashing the canonical string
+    const auto&                bag = _uuids();
+    std::vector<std::uint32_t> shards(SAMPLES);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < SAMPLES; ++i)
+            shards[i] = static_cast<std::uint32_t>(std::hash<std::string>{}(bag[i].string()) % SHARDS);
+        benchmark::DoNotOptimize(std::data(shards));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(BM_ShardString);
+
+template <ShardMethod M>
+static void BM_ShardMany(benchmark::State& state)
+{
+    const auto&                bag = _uuids();
+    std::vector<std::uint32_t> shards(SAMPLES);
+    for (auto _ : state)
+    {
+        shard_many(bag, SHARDS, shards, M);
+        benchmark::DoNotOptimize(std::data(shards));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK_TEMPLATE(BM_ShardMany, ShardMethod::jump);
+BENCHMARK_TEMPLATE(BM_ShardMany, ShardMethod::fast_range);
+
+static void BM_Partition(benchmark::State& state)
+{
+    const auto& bag = _uuids();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto copy = bag;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(partition(copy, SHARDS));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(BM_Partition);
+
+
+
+// time ranges /////////////////////////////////////////////////////////////
+
+static void BM_TimeRange(benchmark::State& state)
+{ // one millisecond window out of a sorted array of 2^range UUIDs
+    using namespace std::chrono;
+    const std::uint64_t start = 1'700'000'000'000'000'000;
+    BasicTimeEngine     gen{ FakeTimeSource{ start, 10'000 } };
+    std::vector<Uuid>   bag(std::size_t{ 1 } << state.range(0));
+    std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+
+    const auto  last = start + 10'000 * std::size(bag);
+    std::size_t i    = 0;
+    for (auto _ : state)
+    {
+        const auto from = system_clock::time_point{ duration_cast<system_clock::duration>(
+            nanoseconds{ start + (i++ * 7'919'000'000) % (last - start) }) };
+        benchmark::DoNotOptimize(time_range(bag, from, from + 1ms));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimeRange)->DenseRange(10, 22, 4);
+
+
+// ordered index ///////////////////////////////////////////////////////////
+
+// what UuidIndex replaces
+struct _locked_set
+{
+    bool insert(const Uuid& u)
+    {
+        std::lock_guard lock{ mtx };
+        return set.insert(u).second;
+    }
+    bool erase(const Uuid& u)
+    {
+        std::lock_guard lock{ mtx };
+        return set.erase(u) != 0;
+    }
+    bool contains(const Uuid& u) const
+    {
+        std::lock_guard lock{ mtx };
+        return set.contains(u);
+    }
+
+    mutable std::mutex mtx;
+    std::set<Uuid>     set;
+};
+
+// 2^20 keys older than any generated by the benchmarks, shared by all threads
+template <typename Index>
+static Index& _filled_index()
+{
+    static const auto index = [] {
+        auto             p = std::make_unique<Index>();
+        BasicTimeEngine  gen{ FakeTimeSource{ 1'600'000'000'000'000'000, 10'000 } };
+        for (std::size_t i = 0; i < (1 << 20); ++i)
+            p->insert(gen());
+        return p;
+    }();
+    return *index;
+}
+
+template <typename Index>
+static void BM_IndexChurn(benchmark::State& state)
+{ // each thread inserts new keys and expires the ones it inserted 1024 iterations earlier
+    auto&             index = _filled_index<Index>();
+    TimeEngine        gen{};
+    std::vector<Uuid> live(1024);
+    std::size_t       i = 0;
+    for (auto _ : state)
+    {
+        auto& slot = live[i++ % std::size(live)];
+        if (i > std::size(live))
+            index.erase(slot);
+        slot = gen();
+        index.insert(slot);
+    }
+    for (std::size_t k = 0; k < std::min(i, std::size(live)); ++k)
+        index.erase(live[k]);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_IndexChurn, UuidIndex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_IndexChurn, _locked_set)->ThreadRange(1, 8)->UseRealTime();
+
+template <typename Index>
+static void BM_IndexContains(benchmark::State& state)
+{ // random keys are absent, but the search goes down to a leaf all the same
+    auto&       index = _filled_index<Index>();
+    const auto& bag   = _uuids();
+    std::size_t i     = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(index.contains(bag[i++ % std::size(bag)]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_IndexContains, UuidIndex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_IndexContains, _locked_set)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_IndexTimeScan(benchmark::State& state)
+{ // one millisecond window, about 100 keys
+    using namespace std::chrono;
+    const std::uint64_t start = 1'600'000'000'000'000'000;
+    const auto&         index = _filled_index<UuidIndex>();
+
+    std::size_t i = 0, visited = 0;
+    for (auto _ : state)
+    {
+        const auto from = system_clock::time_point{ duration_cast<system_clock::duration>(
+            nanoseconds{ start + (i++ * 7'919'000'000) % ((1 << 20) * 10'000ull) }) };
+        index.for_each_in_time(from, from, [&visited](const Uuid&) { ++visited; });
+    }
+    benchmark::DoNotOptimize(visited);
+    state.SetItemsProcessed(static_cast<std::int64_t>(visited));
+}
+BENCHMARK(BM_IndexTimeScan);
+
+
+// scanning ////////////////////////////////////////////////////////////////
+
+static const std::string& _log_text()
+{ // log-like lines, about one UUID every 100 bytes
+    static const auto text = [] {
+        std::string s;
+        for (std::size_t i = 0; s.size() < (std::size_t{ 1 } << 24); ++i)
+            s += "2024-01-01T00:00:00Z INFO request=" + _uuids()[i % SAMPLES].string() + " status=200 elapsed=12ms\n";
+        return s;
+    }();
+    return text;
+}
+
+static void BM_ForEachUuid(benchmark::State& state)
+{
+    const auto& text = _log_text();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(for_each_uuid(text, [](const Uuid& u) { benchmark::DoNotOptimize(u); }));
+    state.SetBytesProcessed(state.iterations() * std::size(text));
+}
+BENCHMARK(BM_ForEachUuid);
+
+static void BM_RegexScan(benchmark::State& state)
+{ // baseline
+    const auto&      text = _log_text();
+    const std::regex pattern{
+        "[[:xdigit:]]{8}-[[:xdigit:]]{4}-[[:xdigit:]]{4}-[[:xdigit:]]{4}-[[:xdigit:]]{12}",
+        std::regex_constants::optimize
+    };
+    const std::string_view head{ std::data(text), std::size_t{ 1 } << 20 }; // regex is too slow for the whole text
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::distance(
+            std::cregex_iterator{ std::data(head), std::data(head) + std::size(head), pattern }, std::cregex_iterator{}));
+    state.SetBytesProcessed(state.iterations() * std::size(head));
+}
+BENCHMARK(BM_RegexScan);
+
+
+
+// generation //////////////////////////////////////////////////////////////
+
+template <typename Engine>
+static void BM_Generate(benchmark::State& state)
+{ // each thread owns its engine, as engines aren't thread-safe
+    Engine gen{};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(gen());
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Engine>
+static void BM_GenerateBatch(benchmark::State& state)
+{
+    Engine            gen{};
+    std::vector<Uuid> bag(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+        benchmark::DoNotOptimize(std::data(bag));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Engine>
+static void BM_Reserve(benchmark::State& state)
+{ // engine shared by all threads, reservations amortize the contention
+    static Engine gen{};
+    for (auto _ : state)
+        for (const auto u : gen.reserve(static_cast<std::size_t>(state.range(0))))
+            benchmark::DoNotOptimize(u);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ParallelGenerate(benchmark::State& state)
+{ // same stream whatever the number of threads
+    std::vector<Uuid> bag(1 << 20);
+    for (auto _ : state)
+    {
+        parallel_generate(bag, 42, 0, static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(std::data(bag));
+    }
+    state.SetItemsProcessed(state.iterations() * std::size(bag));
+}
+BENCHMARK(BM_ParallelGenerate)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+static void BM_SharedTimeEngine(benchmark::State& state)
+{ // threads contend on the segment as processes would
+    static const std::string name = "/uuid-cpp-bench";
+    SharedTimeEngine         gen{ SharedSequence{ name, 7 } };
+    for (auto _ : state)
+        benchmark::DoNotOptimize(gen());
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Engine>
+static void _register_engine(const std::string& name, int max_threads)
+{
+    benchmark::RegisterBenchmark((name + "/single").c_str(), BM_Generate<Engine>)
+        ->ThreadRange(1, max_threads)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark((name + "/batch").c_str(), BM_GenerateBatch<Engine>)
+        ->RangeMultiplier(16)
+        ->Range(16, 4096)
+        ->ThreadRange(1, max_threads)
+        ->UseRealTime();
+    if constexpr (requires(Engine & e) { e.reserve(1); })
+        benchmark::RegisterBenchmark((name + "/reserve").c_str(), BM_Reserve<Engine>)
+            ->RangeMultiplier(16)
+            ->Range(1, 4096)
+            ->ThreadRange(1, max_threads)
+            ->UseRealTime();
+}
+
+
+int main(int argc, char** argv)
+{
+    // thread counts depend on the host, so engines are registered at runtime
+    const auto max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    _register_engine<AddressEngine>("AddressEngine", max_threads);
+    _register_engine<OrderedAddressEngine>("OrderedAddressEngine", max_threads);
+    _register_engine<RandomEngine>("RandomEngine", max_threads);
+    _register_engine<SystemEngine>("SystemEngine", max_threads);
+    _register_engine<TimeEngine>("TimeEngine", max_threads);
+    benchmark::RegisterBenchmark("SharedTimeEngine/single", BM_SharedTimeEngine)
+        ->ThreadRange(1, max_threads)
+        ->UseRealTime();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
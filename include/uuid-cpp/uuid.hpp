@@ -3,6 +3,22 @@
 #define UUID_HPP
 
 #include "uuid-cpp/uuid_core.hpp"
+#include "uuid-cpp/uuid_convert.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+#include "uuid-cpp/uuid_encoding.hpp"
 #include "uuid-cpp/uuid_engine.hpp"
+#include "uuid-cpp/uuid_filter.hpp"
+#include "uuid-cpp/uuid_format.hpp"
+#include "uuid-cpp/uuid_guid.hpp"
+#include "uuid-cpp/uuid_index.hpp"
+#include "uuid-cpp/uuid_interner.hpp"
+#include "uuid-cpp/uuid_range.hpp"
+#include "uuid-cpp/uuid_scan.hpp"
+#include "uuid-cpp/uuid_service.hpp"
+#include "uuid-cpp/uuid_shard.hpp"
+#include "uuid-cpp/uuid_shared.hpp"
+#include "uuid-cpp/uuid_stats.hpp"
+#include "uuid-cpp/uuid_time.hpp"
+#include "uuid-cpp/uuid_validate.hpp"
 
 #endif // !UUID_HPP
\ No newline at end of file
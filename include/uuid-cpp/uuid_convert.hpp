@@ -0,0 +1,59 @@
+#pragma once
+#ifndef UUID_CONVERT_HPP
+#define UUID_CONVERT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace uuid
+{
+    /// @brief Direction of file conversions.
+    enum class ConvertDirection : std::uint8_t
+    {
+        text_to_binary, // newline delimited canonical strings to packed 16 bytes records
+        binary_to_text, // packed 16 bytes records to newline delimited canonical strings
+    };
+
+    struct ConvertOptions
+    {
+        std::size_t threads    = 0;       // number of workers, 0 for the hardware concurrency
+        std::size_t chunk_size = 1 << 20; // approximate lenght of the input of each task, in bytes
+        std::size_t window     = 0;       // maximum number of chunks in flight, 0 for twice the workers
+    };
+
+    /// @brief Input entry that couldn't be converted.
+    struct ConvertError
+    {
+        std::size_t line;   // line, or record, number starting from 1
+        std::size_t offset; // offset of its first byte in the input
+
+        [[nodiscard]] constexpr bool operator==(const ConvertError&) const noexcept = default;
+    };
+
+    struct ConvertResult
+    {
+        std::size_t               converted = 0; // number of UUIDs written
+        std::vector<ConvertError> errors;        // rejected entries, in input order
+    };
+
+    /// @brief Converts a file of UUIDs between text and binary form.
+    ///
+    /// The input is memory mapped and split in chunks at line boundaries, chunks are
+    /// converted by a pool of workers and written in order. Workers stop taking new
+    /// chunks when the writer is a full window behind, which bounds the memory used.
+    ///
+    /// Text input accepts '\n' or "\r\n" line endings and skips empty lines,
+    /// other lines that are not an UUID in canonical form are reported as errors
+    /// without stopping the conversion. So is a truncated record at the end
+    /// of binary input.
+    ///
+    /// Throws std::system_error if the files can't be opened, mapped or written.
+    ///
+    ConvertResult convert_file(const std::filesystem::path& in, const std::filesystem::path& out,
+        ConvertDirection direction, const ConvertOptions& options = {});
+
+} // namespace uuid
+
+#endif // !UUID_CONVERT_HPP
@@ -4,8 +4,13 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -24,6 +29,15 @@
 
 namespace uuid
 {
+    /// @brief Layout variants of UUIDs, from the most significant bits of byte 8.
+    enum class Variant : std::uint8_t
+    {
+        ncs,       // 0xxx    reserved, NCS backward compatibility
+        rfc4122,   // 10xx    the variant specified in [RFC 4122]
+        microsoft, // 110x    reserved, Microsoft Corporation backward compatibility
+        future,    // 111x    reserved for future definition
+    };
+
     /// @brief Universally unique identifier (UUID).
     class alignas(16) Uuid
     {
@@ -79,22 +93,37 @@ namespace uuid
         [[nodiscard]] constexpr bool operator==(const Uuid&) const& noexcept; // = default;
         //[[nodiscard]] constexpr bool operator!=(const Uuid&) const& noexcept = default;
         [[nodiscard]] constexpr bool operator<(const Uuid&) const& noexcept; // = default;
-        //[[nodiscard]] constexpr bool operator>(const Uuid&) const& noexcept  = default;
-        //[[nodiscard]] constexpr bool operator<=(const Uuid&) const& noexcept = default;
-        //[[nodiscard]] constexpr bool operator>=(const Uuid&) const& noexcept = default;
+
+        /// @brief Compares the bytes in order, also provides >, <= and >=.
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const Uuid&) const& noexcept;
 
         /// @brief Resets to null UUID.
         void clear() noexcept { _bytes.fill(std::byte{ 0 }); }
 
         /// @brief Checks whether the UUID is not null.
-        [[nodiscard]] constexpr operator bool() const { return has_value(); }
+        ///
+        /// Explicit, otherwise relational operators would compare the results.
+        ///
+        [[nodiscard]] explicit constexpr operator bool() const { return has_value(); }
 
         /// @brief Checks whether the UUID is not null.
         [[nodiscard]] constexpr bool has_value() const noexcept;
 
+        /// @brief Returns the version, stored in the most significant bits of byte 6.
+        ///
+        /// Only meaningful for UUIDs of the [RFC 4122] variant.
+        ///
+        [[nodiscard]] constexpr std::uint8_t version() const noexcept
+        {
+            return std::to_integer<std::uint8_t>(_bytes[6]) >> 4;
+        }
+
+        /// @brief Returns the variant.
+        [[nodiscard]] constexpr Variant variant() const noexcept;
+
         /// @brief Returns a pointer to the underlying representation.
-        [[nodiscard]] std::byte*       data() noexcept { return std::data(_bytes); }
-        [[nodiscard]] const std::byte* data() const noexcept { return std::data(_bytes); }
+        [[nodiscard]] constexpr std::byte*       data() noexcept { return std::data(_bytes); }
+        [[nodiscard]] constexpr const std::byte* data() const noexcept { return std::data(_bytes); }
 
         /// @brief Returns a canonical string representation.
         [[nodiscard]] std::string string() const;
@@ -125,12 +154,32 @@ namespace uuid
     }
 
 
+    constexpr inline std::strong_ordering Uuid::operator<=>(const Uuid& other) const& noexcept
+    {
+        return std::lexicographical_compare_three_way(
+            std::cbegin(_bytes), std::cend(_bytes),
+            std::cbegin(other._bytes), std::cend(other._bytes));
+    }
+
+
     [[nodiscard]] inline constexpr bool Uuid::has_value() const noexcept
     {
         return !std::all_of(std::cbegin(_bytes), std::cend(_bytes),
             [](auto x) { return x == std::byte{ 0 }; });
     }
 
+    [[nodiscard]] inline constexpr Variant Uuid::variant() const noexcept
+    {
+        const auto b = std::to_integer<std::uint8_t>(_bytes[8]);
+        if ((b & 0x80) == 0)
+            return Variant::ncs;
+        if ((b & 0x40) == 0)
+            return Variant::rfc4122;
+        if ((b & 0x20) == 0)
+            return Variant::microsoft;
+        return Variant::future;
+    }
+
     [[nodiscard]] inline std::string to_string(const Uuid& u) { return u.string(); }
 
     /// @brief Parse a UUID from a string.
@@ -144,6 +193,58 @@ namespace uuid
 
     [[nodiscard]] std::optional<Uuid> try_parse(const std::string_view s) noexcept;
 
+
+    // value of the 8 bytes from offset, most significant first: the halves compare as the UUID
+    [[nodiscard]] constexpr std::uint64_t _big_endian_half(const Uuid& u, std::size_t offset) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        // compilers don't always merge the loop below into a single load
+        if (!std::is_constant_evaluated() && std::endian::native == std::endian::little)
+        {
+            std::uint64_t x;
+            std::memcpy(&x, u.data() + offset, sizeof(x));
+            return __builtin_bswap64(x);
+        }
+#endif
+        std::uint64_t x = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+            x = (x << 8) | std::to_integer<std::uint64_t>(u.data()[offset + i]);
+        return x;
+    }
+
+    // finalizer of MurmurHash3, each input bit flips each output bit with probability about 1/2
+    [[nodiscard]] constexpr std::uint64_t _fmix64(std::uint64_t h) noexcept
+    {
+        h ^= h >> 33;
+        h *= 0xff51'afd7'ed55'8ccd;
+        h ^= h >> 33;
+        h *= 0xc4ce'b9fe'1a85'ec53;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // 64 bits hash of an UUID, shared by std::hash and the probabilistic filters
+    [[nodiscard]] inline std::uint64_t _hash64(const Uuid& u) noexcept
+    {
+        std::uint64_t hi, lo;
+        std::memcpy(&hi, u.data(), sizeof(hi));
+        std::memcpy(&lo, u.data() + sizeof(hi), sizeof(lo));
+
+        // time-based versions keep most of the entropy in the few low bits of
+        // the counter, in the high half: every bit must reach the whole hash
+        return _fmix64(hi ^ _fmix64(lo));
+    }
+
 } // namespace uuid
 
+
+template <>
+struct std::hash<uuid::Uuid>
+{
+    [[nodiscard]] std::size_t operator()(const uuid::Uuid& u) const noexcept
+    {
+        return static_cast<std::size_t>(uuid::_hash64(u));
+    }
+};
+
 #endif // !UUID_CORE_HPP
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef UUID_DISPATCH_HPP
+#define UUID_DISPATCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+// vector kernels are compiled for their own instruction set, whatever the target of the build,
+// and only run if the processor supports it
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define UUID_CPP_SIMD_X86 1
+#define UUID_CPP_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define UUID_CPP_SIMD_X86 1
+#define UUID_CPP_TARGET(isa)
+#else
+#define UUID_CPP_TARGET(isa)
+#endif
+
+namespace uuid
+{
+    /// @brief Instruction sets of the vector kernels.
+    ///
+    /// x86 levels are ordered, each one implies the previous ones.
+    ///
+    enum class SimdLevel : std::uint8_t
+    {
+        scalar,
+        neon,
+        sse2,
+        ssse3,
+        avx2,
+        avx512,
+    };
+
+    constexpr std::size_t SIMD_LEVEL_COUNT = 6;
+
+    /// @brief Returns the name of a level, as accepted by the UUID_CPP_SIMD variable.
+    [[nodiscard]] std::string_view to_string(SimdLevel level) noexcept;
+
+    /// @brief Parses the name of a level.
+    [[nodiscard]] std::optional<SimdLevel> try_parse_simd_level(std::string_view name) noexcept;
+
+    /// @brief Returns the best level supported by the processor, detected once.
+    [[nodiscard]] SimdLevel detected_simd_level() noexcept;
+
+    /// @brief Returns true if the kernels of the level can run on the processor.
+    [[nodiscard]] bool simd_supported(SimdLevel level) noexcept;
+
+    /// @brief Selects the kernels used from now on by all threads.
+    ///
+    /// Meant for tests and benchmarks of each code path. Throws
+    /// std::invalid_argument if the processor doesn't support the level.
+    ///
+    void set_simd_level(SimdLevel level);
+
+
+    // level of the kernels in use, SIMD_LEVEL_COUNT until initialized
+    inline std::atomic<std::uint8_t> _simd_level{ SIMD_LEVEL_COUNT };
+
+    // picks the detected level, or the one in the UUID_CPP_SIMD environment variable
+    [[nodiscard]] SimdLevel _init_simd_level() noexcept;
+
+    /// @brief Returns the level of the kernels in use.
+    [[nodiscard]] inline SimdLevel simd_level() noexcept
+    {
+        const auto level = _simd_level.load(std::memory_order_relaxed);
+        if (level == SIMD_LEVEL_COUNT) [[unlikely]]
+            return _init_simd_level();
+        return static_cast<SimdLevel>(level);
+    }
+
+    // level used in place of the given one when it has no kernel, or isn't supported
+    [[nodiscard]] constexpr SimdLevel _simd_fallback(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case SimdLevel::neon:
+        case SimdLevel::sse2:
+            return SimdLevel::scalar;
+        case SimdLevel::ssse3:
+            return SimdLevel::sse2;
+        case SimdLevel::avx2:
+            return SimdLevel::ssse3;
+        case SimdLevel::avx512:
+            return SimdLevel::avx2;
+        default:
+            return SimdLevel::scalar;
+        }
+    }
+
+    /// @brief Table of the implementations of a kernel, one for each level.
+    ///
+    /// Levels without an implementation use the one of their fallback level.
+    ///
+    template <typename F>
+    class _kernel_table
+    {
+    public:
+        constexpr _kernel_table(F* scalar, std::initializer_list<std::pair<SimdLevel, F*>> kernels) noexcept
+        {
+            // fallbacks always come earlier in the enumeration, so they are already set
+            for (std::size_t l = 0; l < SIMD_LEVEL_COUNT; ++l)
+            {
+                _kernels[l] = (l == 0) ? scalar : _kernels[static_cast<std::size_t>(_simd_fallback(static_cast<SimdLevel>(l)))];
+                for (const auto& [level, kernel] : kernels)
+                    if (static_cast<std::size_t>(level) == l)
+                        _kernels[l] = kernel;
+            }
+        }
+
+        /// @brief Returns the kernel of the level in use.
+        [[nodiscard]] F* get() const noexcept { return _kernels[static_cast<std::size_t>(simd_level())]; }
+
+    private:
+        std::array<F*, SIMD_LEVEL_COUNT> _kernels{};
+    };
+
+} // namespace uuid
+
+#endif // !UUID_DISPATCH_HPP
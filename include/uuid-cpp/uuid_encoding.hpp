@@ -0,0 +1,103 @@
+#pragma once
+#ifndef UUID_ENCODING_HPP
+#define UUID_ENCODING_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace uuid
+{
+    // lenght of a UUID in base64url string form (RFC 4648 section 5, no padding)
+    constexpr std::size_t UUID_BASE64_STRING_SIZE = 22;
+
+    // lenght of a UUID in Crockford's base32 string form
+    constexpr std::size_t UUID_BASE32_STRING_SIZE = 26;
+
+    // lenght of a UUID in base58 string form (Bitcoin alphabet, zero-padded)
+    constexpr std::size_t UUID_BASE58_STRING_SIZE = 22;
+
+
+    /// @brief Writes the base64url representation of an UUID.
+    ///
+    /// Uses the URL and filename safe alphabet of [RFC 4648] without padding.
+    ///
+    void to_base64(const Uuid& u, std::span<char, UUID_BASE64_STRING_SIZE> out) noexcept;
+
+    /// @brief Returns the base64url representation of an UUID.
+    [[nodiscard]] std::string to_base64(const Uuid& u);
+
+    /// @brief Parse a UUID from its base64url representation.
+    [[nodiscard]] Uuid parse_base64(const std::string_view s);
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base64(const std::string_view s) noexcept;
+
+    /// @brief Writes the base64url representations of many UUIDs back to back.
+    ///
+    /// The output buffer must hold UUID_BASE64_STRING_SIZE chars for each UUID.
+    ///
+    void to_base64_many(std::span<const Uuid> in, std::span<char> out) noexcept;
+
+    /// @brief Parse many UUIDs from back to back base64url representations.
+    ///
+    /// Stops at the first ill-formed entry.
+    /// @return The number of UUIDs successfully parsed.
+    ///
+    [[nodiscard]] std::size_t try_parse_base64_many(std::span<const char> in, std::span<Uuid> out) noexcept;
+
+
+    /// @brief Writes the Crockford's base32 representation of an UUID.
+    ///
+    /// Digits are emitted most significant first, so the textual ordering
+    /// matches the ordering of the underlying bytes.
+    ///
+    void to_base32(const Uuid& u, std::span<char, UUID_BASE32_STRING_SIZE> out) noexcept;
+
+    /// @brief Returns the Crockford's base32 representation of an UUID.
+    [[nodiscard]] std::string to_base32(const Uuid& u);
+
+    /// @brief Parse a UUID from its Crockford's base32 representation.
+    ///
+    /// Decoding is case insensitive and accepts the 'I', 'L' and 'O' aliases.
+    ///
+    [[nodiscard]] Uuid parse_base32(const std::string_view s);
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base32(const std::string_view s) noexcept;
+
+    /// @brief Writes the base32 representations of many UUIDs back to back.
+    void to_base32_many(std::span<const Uuid> in, std::span<char> out) noexcept;
+
+    /// @brief Parse many UUIDs from back to back base32 representations.
+    /// @return The number of UUIDs successfully parsed.
+    [[nodiscard]] std::size_t try_parse_base32_many(std::span<const char> in, std::span<Uuid> out) noexcept;
+
+
+    /// @brief Writes the base58 representation of an UUID.
+    ///
+    /// Output has fixed width (left padded with '1', the zero digit),
+    /// so the textual ordering matches the ordering of the underlying bytes.
+    ///
+    void to_base58(const Uuid& u, std::span<char, UUID_BASE58_STRING_SIZE> out) noexcept;
+
+    /// @brief Returns the base58 representation of an UUID.
+    [[nodiscard]] std::string to_base58(const Uuid& u);
+
+    /// @brief Parse a UUID from its base58 representation.
+    [[nodiscard]] Uuid parse_base58(const std::string_view s);
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base58(const std::string_view s) noexcept;
+
+    /// @brief Writes the base58 representations of many UUIDs back to back.
+    void to_base58_many(std::span<const Uuid> in, std::span<char> out) noexcept;
+
+    /// @brief Parse many UUIDs from back to back base58 representations.
+    /// @return The number of UUIDs successfully parsed.
+    [[nodiscard]] std::size_t try_parse_base58_many(std::span<const char> in, std::span<Uuid> out) noexcept;
+
+} // namespace uuid
+
+#endif // !UUID_ENCODING_HPP
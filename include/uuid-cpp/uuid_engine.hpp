@@ -3,36 +3,388 @@
 #define UUID_ENGINE_HPP
 
 #include "uuid-cpp/uuid_core.hpp"
+#include "uuid-cpp/uuid_range.hpp"
+#include "uuid-cpp/uuid_stats.hpp"
+#include "uuid-cpp/uuid_time.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace uuid
 {
+    // 64 bits from std::random_device, or mixed from the pid and clock if it throws
+    [[nodiscard]] std::uint64_t _system_entropy() noexcept;
+
+    // helpers shared by the time-based engines
+    [[nodiscard]] std::uint16_t            _init_clock_sequence() noexcept;
+    [[nodiscard]] std::array<std::byte, 6> _init_mac_address();
+    [[nodiscard]] std::uint64_t            _init_random_node() noexcept;
+
+
+    // bumped in the child process after each fork, and by reseed_engines()
+    inline std::atomic<std::uint32_t> _reseed_generation{ 0 };
+
+    // registers the fork handler on first use, returns the current generation
+    [[nodiscard]] std::uint32_t _watch_reseed() noexcept;
+
+    /// @brief Makes all the engines reseed their random state on their next call.
+    ///
+    /// Forked child processes do this automatically, call it after events that
+    /// duplicate the process state in other ways, like restoring a VM snapshot.
+    ///
+    void reseed_engines() noexcept;
+
+
+    // random value of an engine, drawn again when the reseed generation changes
+    class _reseeded_value
+    {
+    public:
+        template <typename F>
+        explicit _reseeded_value(F&& init)
+            : _generation{ _watch_reseed() }
+            , _value{ init() }
+        {
+        }
+
+        _reseeded_value(const _reseeded_value& other) noexcept
+            : _generation{ other._generation.load(std::memory_order_relaxed) }
+            , _value{ other._value.load(std::memory_order_relaxed) }
+        {
+        }
+
+        _reseeded_value& operator=(const _reseeded_value& other) noexcept
+        {
+            _generation.store(other._generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _value.store(other._value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        /// @brief Returns the value, first drawing a new one with init() if stale.
+        ///
+        /// A plain atomic load on the fast path, no system calls.
+        ///
+        template <typename F>
+        [[nodiscard]] std::uint64_t get(F&& init) noexcept
+        {
+            static_assert(std::is_nothrow_invocable_v<F&>, "Reseeding can't fail in a generation");
+            const auto generation = _reseed_generation.load(std::memory_order_acquire);
+            if (_generation.load(std::memory_order_acquire) != generation) [[unlikely]]
+            {
+                _value.store(init(), std::memory_order_relaxed);
+                _generation.store(generation, std::memory_order_release);
+            }
+            return _value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::uint32_t> _generation;
+        std::atomic<std::uint64_t> _value;
+    };
+
+
+    /// @brief Shared state from which time-based engines claim their time and sequence values.
+    ///
+    /// claim() returns a value above _TIME_ORDERED_VALUE_MAX, and claims
+    /// nothing, if the n values don't fit in the 60 bits field.
+    ///
+    template <typename T>
+    concept TimeSequence = std::copyable<T> && requires(T& sequence, std::uint64_t now, EngineKind kind)
+    {
+        { sequence.claim(now, now, kind, 0u) } noexcept -> std::same_as<std::uint64_t>;
+    };
+
+    // claims n consecutive values after the last one, or from now if it is ahead;
+    // prev receives the last value claimed before
+    [[nodiscard]] inline std::uint64_t _claim_after(
+        std::atomic<std::uint64_t>& last, std::uint64_t now, std::uint64_t n, std::uint64_t& prev) noexcept
+    {
+        prev = last.load(std::memory_order_relaxed);
+        std::uint64_t first;
+        do
+        {
+            first = std::max(now, prev + 1);
+            // checked before publishing, a wrapped last value would repeat for every engine sharing it
+            if (first > _TIME_ORDERED_VALUE_MAX || n > _TIME_ORDERED_VALUE_MAX - first + 1) [[unlikely]]
+                return _TIME_ORDERED_VALUE_MAX + 1;
+        } while (n != 0 && !last.compare_exchange_weak(prev, first + n - 1, std::memory_order_relaxed));
+        return first;
+    }
+
+    // counts the claim of n values from first at the given clock reading, timestamps
+    // being the bits above shift: a reading behind the timestamp of the previous
+    // value is a clock backstep, a block running past the one of the reading an overflow
+    inline void _stats_claim([[maybe_unused]] EngineKind kind, [[maybe_unused]] std::uint64_t now,
+        [[maybe_unused]] std::uint64_t prev, [[maybe_unused]] std::uint64_t first,
+        [[maybe_unused]] std::uint64_t n, [[maybe_unused]] unsigned shift) noexcept
+    {
+#if UUID_CPP_ENABLE_STATS
+        if ((now >> shift) < (prev >> shift)) [[unlikely]]
+            _stats_count(kind, _stats_counter::clock_backsteps);
+        else if (n != 0 && ((first + n - 1) >> shift) > (now >> shift)) [[unlikely]]
+            _stats_count(kind, _stats_counter::counter_overflows);
+#endif
+    }
+
+
+    // time and sequence state of the time-based engines, copies share it:
+    // engines copied from one another keep the same node and must not repeat values
+    class _time_sequence
+    {
+    public:
+        _time_sequence()
+            : _state{ std::make_shared<_state_block>() }
+        {
+        }
+
+        /// @brief Atomically claims n consecutive values.
+        ///
+        /// Values never repeat: the block starts from the clock reading if it
+        /// is ahead of the last value claimed, right after it otherwise (clock
+        /// regressions, repeated readings of coarse sources, exhausted counters).
+        /// Readings behind the timestamp of the last value, the bits above
+        /// shift, are reported as clock backsteps, blocks running past the
+        /// timestamp of the reading as counter overflows.
+        ///
+        [[nodiscard]] std::uint64_t claim(std::uint64_t now, std::uint64_t n,
+            [[maybe_unused]] EngineKind kind, [[maybe_unused]] unsigned shift) noexcept
+        {
+            std::uint64_t prev;
+            const auto    first = _claim_after(_state->last, now, n, prev);
+            _stats_claim(kind, now, prev, first, n, shift);
+            return first;
+        }
+
+    private:
+        struct _state_block
+        {
+            std::atomic<std::uint64_t> last{ 0 }; // last value claimed
+        };
+
+        std::shared_ptr<_state_block> _state;
+    };
+
+
+    // sequences that know the version of their values must match the engine
+    template <TimeSequence Sequence>
+    [[nodiscard]] Sequence _check_sequence(Sequence sequence, std::uint8_t version)
+    {
+        if constexpr (requires { sequence.version(); })
+            if (sequence.version() != version)
+                throw std::invalid_argument{ "Sequence of another UUID version" };
+        return sequence;
+    }
+
+
+    // engine from the MAC address of the host, the timestamp, clock sequence and node
+    // of [RFC 4122] laid out as the given version, 1 or 6
+    template <std::uint8_t Version, TimeSource Source, TimeSequence Sequence>
+    class _address_engine
+    {
+        static_assert(Version == 1 || Version == 6);
+
+    public:
+        _address_engine(Sequence sequence, Source source)
+            : _source{ std::move(source) }
+            , _sequence{ _check_sequence(std::move(sequence), Version) }
+            , _mac{ _init_mac_address() }
+            , _node{ [this]() noexcept { return _make_node(); } }
+        {
+        }
+
+        _address_engine(const _address_engine&) = default;
+        _address_engine& operator=(const _address_engine&) = default;
+
+        /// @brief Generates a new UUID.
+        [[nodiscard]] Uuid operator()() noexcept
+        {
+            const _stats_scope scope{ EngineKind::address };
+            return _build_time_based(Version, _claim(1), _current_node());
+        }
+
+        /// @brief Reserves a block of n consecutive UUIDs.
+        ///
+        /// The cost of a reservation doesn't depend on its size.
+        /// Throws std::length_error if the block doesn't fit in the time and
+        /// sequence field, nothing is claimed then.
+        ///
+        [[nodiscard]] UuidRange reserve(std::size_t n)
+        {
+            const auto first = _claim(n);
+            if (first > _TIME_ORDERED_VALUE_MAX) [[unlikely]]
+                throw std::length_error{ "Reservation exceeds the time-ordered values" };
+
+            _stats_count(EngineKind::address, _stats_counter::generated, n);
+            return UuidRange{ Version, first, n, _current_node() };
+        }
+
+    private:
+        [[nodiscard]] std::uint64_t _claim(std::uint64_t n) noexcept
+        {
+            return _sequence.claim(_version_1_timestamp(_source.now()), n, EngineKind::address, 0);
+        }
+
+        // the clock sequence is drawn again after a fork, as the MAC address can't tell processes apart
+        [[nodiscard]] std::uint64_t _make_node() const noexcept
+        {
+            std::uint64_t node = std::uint64_t{ _init_clock_sequence() } << 48;
+            for (std::size_t i = 0; i < std::size(_mac); ++i)
+                node |= std::to_integer<std::uint64_t>(_mac[i]) << ((5 - i) * 8);
+            return _with_variant(node);
+        }
+
+        [[nodiscard]] std::uint64_t _current_node() noexcept
+        {
+            return _node.get([this]() noexcept { return _make_node(); });
+        }
+
+        Source                   _source;
+        Sequence                 _sequence;
+        std::array<std::byte, 6> _mac;
+        _reseeded_value          _node; // clock sequence and MAC address
+    };
+
+
     /// @brief Generates UUIDs from the MAC address of the host.
     ///
-    /// Time-based version as specified in [RFC 4122].
+    /// Time-based version 1 as specified in [RFC 4122]. Its timestamp is
+    /// stored least significant first, so UUIDs don't sort by creation time,
+    /// see BasicOrderedAddressEngine for that.
     /// Requires access to the MAC address of the current machine.
+    /// Timestamps are read from the given time source, the default one reads
+    /// the precise system clock, see CoarseTimeSource and TickerTimeSource
+    /// for cheaper alternatives.
+    /// Can be shared between threads if the time source can.
+    /// The sequence can be shared with other engines, see SharedSequence,
+    /// copies share the sequence of the engine they were copied from.
+    ///
+    template <TimeSource Source = SystemTimeSource, TimeSequence Sequence = _time_sequence>
+    class BasicAddressEngine : public _address_engine<1, Source, Sequence>
+    {
+    public:
+        explicit BasicAddressEngine(Source source = Source{})
+            : BasicAddressEngine{ Sequence{}, std::move(source) }
+        {
+        }
+
+        explicit BasicAddressEngine(Sequence sequence, Source source = Source{})
+            : _address_engine<1, Source, Sequence>{ std::move(sequence), std::move(source) }
+        {
+        }
+    };
+
+    using AddressEngine = BasicAddressEngine<>;
+
+
+    /// @brief Generates UUIDs ordered by creation time from the MAC address of the host.
     ///
-    class AddressEngine
+    /// Version 6 as specified in [RFC 9562]: the fields of BasicAddressEngine,
+    /// with the timestamp stored most significant first so that UUIDs sort
+    /// by creation time.
+    ///
+    template <TimeSource Source = SystemTimeSource, TimeSequence Sequence = _time_sequence>
+    class BasicOrderedAddressEngine : public _address_engine<6, Source, Sequence>
     {
     public:
-        explicit AddressEngine();
+        explicit BasicOrderedAddressEngine(Source source = Source{})
+            : BasicOrderedAddressEngine{ Sequence{}, std::move(source) }
+        {
+        }
+
+        explicit BasicOrderedAddressEngine(Sequence sequence, Source source = Source{})
+            : _address_engine<6, Source, Sequence>{ std::move(sequence), std::move(source) }
+        {
+        }
+    };
 
-        AddressEngine(const AddressEngine&) = default;
-        AddressEngine& operator=(const AddressEngine&) = default;
+    using OrderedAddressEngine = BasicOrderedAddressEngine<>;
+
+
+    /// @brief Generates UUIDs ordered by Unix time.
+    ///
+    /// Version 7 as specified in [RFC 9562]: 48 bits of milliseconds
+    /// followed by a 12 bits counter, that spills into the next millisecond
+    /// when exhausted. The remaining 62 bits are drawn at random once per
+    /// engine and act as a node identifier.
+    /// Can be shared between threads if the time source can.
+    /// The sequence can be shared with other engines, see SharedSequence,
+    /// copies share the sequence of the engine they were copied from.
+    ///
+    template <TimeSource Source = SystemTimeSource, TimeSequence Sequence = _time_sequence>
+    class BasicTimeEngine
+    {
+    public:
+        explicit BasicTimeEngine(Source source = Source{})
+            : BasicTimeEngine{ Sequence{}, std::move(source) }
+        {
+        }
+
+        explicit BasicTimeEngine(Sequence sequence, Source source = Source{})
+            : _source{ std::move(source) }
+            , _sequence{ _check_sequence(std::move(sequence), 7) }
+            , _node{ _make_node }
+        {
+        }
+
+        BasicTimeEngine(const BasicTimeEngine&) = default;
+        BasicTimeEngine& operator=(const BasicTimeEngine&) = default;
 
         /// @brief Generates a new UUID.
-        [[nodiscard]] Uuid operator()() const noexcept;
+        [[nodiscard]] Uuid operator()() noexcept
+        {
+            const _stats_scope scope{ EngineKind::time };
+            return _build_time_ordered(7, _claim(1), _node.get(_make_node));
+        }
+
+        /// @brief Reserves a block of n consecutive UUIDs.
+        ///
+        /// The cost of a reservation doesn't depend on its size,
+        /// large blocks spill over the following milliseconds.
+        /// Throws std::length_error if the block doesn't fit in the time and
+        /// counter field, nothing is claimed then.
+        ///
+        [[nodiscard]] UuidRange reserve(std::size_t n)
+        {
+            const auto first = _claim(n);
+            if (first > _TIME_ORDERED_VALUE_MAX) [[unlikely]]
+                throw std::length_error{ "Reservation exceeds the time-ordered values" };
+
+            _stats_count(EngineKind::time, _stats_counter::generated, n);
+            return UuidRange{ 7, first, n, _node.get(_make_node) };
+        }
 
     private:
-        const std::uint16_t      _clock; // stays fixed for the lifetime of the generator
-        std::array<std::byte, 6> _mac;
+        [[nodiscard]] std::uint64_t _claim(std::uint64_t n) noexcept
+        {
+            return _sequence.claim(_version_7_timestamp(_source.now()), n, EngineKind::time, 12);
+        }
+
+        [[nodiscard]] static std::uint64_t _make_node() noexcept
+        {
+            return _with_variant(_init_random_node());
+        }
+
+        Source          _source;
+        Sequence        _sequence;
+        _reseeded_value _node; // drawn again after a fork
     };
 
+    using TimeEngine = BasicTimeEngine<>;
+
 
     /// @brief Generates UUIDs from a pseudo-random number source.
+    ///
+    /// Reseeds itself in forked child processes and after reseed_engines().
+    ///
     class RandomEngine
     {
     public:
@@ -46,11 +398,109 @@ namespace uuid
         [[nodiscard]] Uuid operator()() noexcept;
 
     private:
+        void _reseed() noexcept;
+
         std::mt19937_64 _timestamp_gen;
         std::mt19937_64 _clock_and_node_gen;
+        std::uint32_t   _generation; // of the last reseed
     };
 
 
+    // Philox4x32-10 block of 128 bits, see [Salmon et al., Parallel Random Numbers: As Easy as 1, 2, 3]
+    [[nodiscard]] constexpr std::array<std::uint32_t, 4> _philox(
+        std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key) noexcept
+    {
+        constexpr std::uint64_t PHILOX_M0 = 0xd251'1f53;
+        constexpr std::uint64_t PHILOX_M1 = 0xcd9e'8d57;
+        constexpr std::uint32_t PHILOX_W0 = 0x9e37'79b9;
+        constexpr std::uint32_t PHILOX_W1 = 0xbb67'ae85;
+
+        for (int round = 0; round < 10; ++round)
+        {
+            if (round != 0)
+            {
+                key[0] += PHILOX_W0;
+                key[1] += PHILOX_W1;
+            }
+            const std::uint64_t p0 = PHILOX_M0 * counter[0];
+            const std::uint64_t p1 = PHILOX_M1 * counter[2];
+            counter                = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(p0),
+            };
+        }
+        return counter;
+    }
+
+
+    /// @brief Generates version 4 UUIDs from a counter-based pseudo-random function.
+    ///
+    /// The i-th UUID of the stream is the Philox4x32-10 block of the counter
+    /// (i, stream) under the seed as key, so that any position can be computed
+    /// in constant time and threads can split a sequence without coordination.
+    /// Sequences are reproducible across platforms, but they are predictable
+    /// from the seed: meant for test fixtures and simulations, not identifiers
+    /// that must be hard to guess.
+    ///
+    class PhiloxEngine
+    {
+    public:
+        explicit constexpr PhiloxEngine(std::uint64_t seed, std::uint64_t stream = 0) noexcept
+            : _key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }
+            , _stream{ stream }
+        {
+        }
+
+        /// @brief Generates the UUID at the current position and advances it.
+        [[nodiscard]] constexpr Uuid operator()() noexcept { return at(_position++); }
+
+        /// @brief Returns the UUID at the given position of the stream.
+        [[nodiscard]] constexpr Uuid at(std::uint64_t index) const noexcept
+        {
+            const auto block = _philox({ static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                                           static_cast<std::uint32_t>(_stream), static_cast<std::uint32_t>(_stream >> 32) },
+                _key);
+
+            std::array<std::byte, 16> bytes{};
+            for (std::size_t i = 0; i < std::size(bytes); ++i)
+                bytes[i] = static_cast<std::byte>(block[i / 4] >> ((3 - i % 4) * 8));
+            bytes[6] = (bytes[6] & std::byte{ 0x0f }) | std::byte{ 0x40 };
+            bytes[8] = (bytes[8] & std::byte{ 0x3f }) | std::byte{ 0x80 };
+            return Uuid{ bytes };
+        }
+
+        /// @brief Skips the next n UUIDs.
+        constexpr void discard(std::uint64_t n) noexcept { _position += n; }
+
+        /// @brief Returns the position of the next UUID.
+        [[nodiscard]] constexpr std::uint64_t position() const noexcept { return _position; }
+
+        /// @brief Fills the span with the next UUIDs.
+        constexpr void generate(std::span<Uuid> out) noexcept
+        {
+            for (auto& u : out)
+                u = at(_position++);
+        }
+
+        [[nodiscard]] constexpr bool operator==(const PhiloxEngine&) const noexcept = default;
+
+    private:
+        std::array<std::uint32_t, 2> _key;
+        std::uint64_t                _stream;
+        std::uint64_t                _position = 0;
+    };
+
+    /// @brief Fills the span with the first UUIDs of a PhiloxEngine stream, in parallel.
+    ///
+    /// The result is identical to PhiloxEngine{ seed, stream }.generate(out)
+    /// whatever the number of threads, each one filling a contiguous block.
+    /// @param threads Number of threads, 0 for the hardware concurrency.
+    ///
+    void parallel_generate(std::span<Uuid> out, std::uint64_t seed, std::uint64_t stream = 0, std::size_t threads = 0);
+
+
     /// @brief Generates UUIDs from native system APIs.
     class SystemEngine
     {
@@ -0,0 +1,132 @@
+#pragma once
+#ifndef UUID_FILTER_HPP
+#define UUID_FILTER_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace uuid
+{
+    /// @brief Approximate membership test over a set of UUIDs.
+    ///
+    /// Filters answer false only for UUIDs that are not in the set,
+    /// and true for all members plus a small fraction of false positives.
+    ///
+    template <typename T>
+    concept Filter = requires(const T& filter, const Uuid& u, std::span<const Uuid> in, std::span<bool> out)
+    {
+        { filter.contains(u) } noexcept -> std::same_as<bool>;
+        { filter.contains_many(in, out) } noexcept -> std::same_as<std::size_t>;
+        { filter.serialized_size() } noexcept -> std::same_as<std::size_t>;
+    };
+
+    // lenght of the header of serialized filters
+    constexpr std::size_t FILTER_HEADER_SIZE = 32;
+
+    // required alignment of buffers viewed as filters
+    constexpr std::size_t FILTER_BUFFER_ALIGNMENT = 32;
+
+
+    /// @brief Split block Bloom filter.
+    ///
+    /// Each UUID sets one bit in each of the eight 32 bits words of a single
+    /// 256 bits block, so that a query touches only one cache line.
+    /// With the default of 10 bits per UUID, false positives are about 1%.
+    ///
+    class BloomFilter
+    {
+    public:
+        /// @brief Constructs an empty filter.
+        BloomFilter() noexcept = default;
+
+        /// @brief Builds the filter of a set of UUIDs.
+        explicit BloomFilter(std::span<const Uuid> keys, double bits_per_key = 10.0);
+
+        /// @brief Views a buffer written by serialize() as a filter, without copying it.
+        ///
+        /// The buffer, usually a memory mapped file, must outlive the filter
+        /// and be aligned to FILTER_BUFFER_ALIGNMENT bytes.
+        /// Throws std::invalid_argument if the buffer doesn't hold a Bloom filter.
+        ///
+        [[nodiscard]] static BloomFilter view(std::span<const std::byte> buffer);
+
+        [[nodiscard]] bool contains(const Uuid& u) const noexcept;
+
+        /// @brief Tests many UUIDs, out[i] receives the result for in[i].
+        /// @return The number of UUIDs that might be in the set.
+        ///
+        std::size_t contains_many(std::span<const Uuid> in, std::span<bool> out) const noexcept;
+
+        /// @brief Returns the lenght of the filter in serialized form.
+        [[nodiscard]] std::size_t serialized_size() const noexcept;
+
+        /// @brief Writes the filter in a flat form, that can be viewed in place.
+        ///
+        /// Integers are stored with the native byte order.
+        ///
+        void serialize(std::span<std::byte> out) const noexcept;
+
+    private:
+        std::shared_ptr<const void> _owner; // null for views
+        const std::uint32_t*        _words       = nullptr;
+        std::size_t                 _block_count = 0;
+    };
+
+
+    /// @brief Static xor filter with 8 bits fingerprints.
+    ///
+    /// Takes about 9.84 bits per UUID for a false positive rate of 0.4%,
+    /// and a query reads three bytes. The set can't be changed after construction.
+    /// See T. M. Graf, D. Lemire "Xor Filters: Faster and Smaller Than Bloom and Cuckoo Filters".
+    ///
+    class XorFilter
+    {
+    public:
+        /// @brief Constructs an empty filter.
+        XorFilter() noexcept = default;
+
+        /// @brief Builds the filter of a set of UUIDs, duplicates are allowed.
+        explicit XorFilter(std::span<const Uuid> keys);
+
+        /// @brief Views a buffer written by serialize() as a filter, without copying it.
+        ///
+        /// The buffer, usually a memory mapped file, must outlive the filter
+        /// and be aligned to FILTER_BUFFER_ALIGNMENT bytes.
+        /// Throws std::invalid_argument if the buffer doesn't hold a xor filter.
+        ///
+        [[nodiscard]] static XorFilter view(std::span<const std::byte> buffer);
+
+        [[nodiscard]] bool contains(const Uuid& u) const noexcept;
+
+        /// @brief Tests many UUIDs, out[i] receives the result for in[i].
+        /// @return The number of UUIDs that might be in the set.
+        ///
+        std::size_t contains_many(std::span<const Uuid> in, std::span<bool> out) const noexcept;
+
+        /// @brief Returns the lenght of the filter in serialized form.
+        [[nodiscard]] std::size_t serialized_size() const noexcept;
+
+        /// @brief Writes the filter in a flat form, that can be viewed in place.
+        ///
+        /// Integers are stored with the native byte order.
+        ///
+        void serialize(std::span<std::byte> out) const noexcept;
+
+    private:
+        std::shared_ptr<const void> _owner; // null for views
+        const std::uint8_t*         _fingerprints = nullptr;
+        std::uint64_t               _seed         = 0;
+        std::size_t                 _block_length = 0;
+    };
+
+    static_assert(Filter<BloomFilter>);
+    static_assert(Filter<XorFilter>);
+
+} // namespace uuid
+
+#endif // !UUID_FILTER_HPP
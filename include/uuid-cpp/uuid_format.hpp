@@ -0,0 +1,121 @@
+#pragma once
+#ifndef UUID_FORMAT_HPP
+#define UUID_FORMAT_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if UUID_CPP_WITH_FMT
+#include <fmt/format.h>
+#endif
+
+namespace uuid
+{
+    // lenght of the longest formatted representation, "urn:uuid:" and canonical form
+    constexpr std::size_t UUID_FORMAT_MAX_SIZE = 9 + 36;
+
+    /// @brief Options of formatted representations.
+    ///
+    /// Format specs are made of any of the following flags:
+    ///     X   uppercase hexadecimal digits
+    ///     x   lowercase hexadecimal digits (default)
+    ///     n   no hyphens, 32 digits only
+    ///     b   enclosed in braces, {xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}
+    ///     u   prefixed by "urn:uuid:", as in [RFC 4122]
+    ///
+    struct _format_spec
+    {
+        bool upper   = false;
+        bool compact = false;
+        char wrap    = 0; // 'b', 'u' or none
+    };
+
+    /// @brief Parses a format spec, stops at the first character that isn't part of it.
+    template <typename It>
+    [[nodiscard]] constexpr It _parse_format_spec(It first, It last, _format_spec& spec) noexcept
+    {
+        for (; first != last; ++first)
+        {
+            switch (*first)
+            {
+                case 'X': spec.upper = true; break;
+                case 'x': spec.upper = false; break;
+                case 'n': spec.compact = true; break;
+                case 'b':
+                case 'u':
+                    if (spec.wrap != 0 && spec.wrap != *first)
+                        return first; // braces and urn prefix are exclusive
+                    spec.wrap = static_cast<char>(*first);
+                    break;
+                default: return first;
+            }
+        }
+        return first;
+    }
+
+    /// @brief Writes the representation of an UUID described by the spec.
+    /// @return The number of characters written.
+    ///
+    std::size_t _format_to(const Uuid& u, _format_spec spec, std::span<char, UUID_FORMAT_MAX_SIZE> out) noexcept;
+
+} // namespace uuid
+
+
+#if __cpp_lib_format
+template <>
+struct std::formatter<uuid::Uuid>
+{
+    constexpr auto parse(std::format_parse_context& ctx)
+    {
+        const auto it = uuid::_parse_format_spec(ctx.begin(), ctx.end(), _spec);
+        if (it != ctx.end() && *it != '}')
+            throw std::format_error{ "Invalid format spec for uuid::Uuid" };
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const uuid::Uuid& u, FormatContext& ctx) const
+    {
+        char       buffer[uuid::UUID_FORMAT_MAX_SIZE];
+        const auto n = uuid::_format_to(u, _spec, buffer);
+        return std::copy_n(buffer, n, ctx.out());
+    }
+
+private:
+    uuid::_format_spec _spec;
+};
+#endif
+
+#if UUID_CPP_WITH_FMT
+template <>
+struct fmt::formatter<uuid::Uuid>
+{
+    constexpr auto parse(fmt::format_parse_context& ctx)
+    {
+        const auto it = uuid::_parse_format_spec(ctx.begin(), ctx.end(), _spec);
+        if (it != ctx.end() && *it != '}')
+            throw fmt::format_error{ "Invalid format spec for uuid::Uuid" };
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const uuid::Uuid& u, FormatContext& ctx) const
+    {
+        char       buffer[uuid::UUID_FORMAT_MAX_SIZE];
+        const auto n = uuid::_format_to(u, _spec, buffer);
+        return std::copy_n(buffer, n, ctx.out());
+    }
+
+private:
+    uuid::_format_spec _spec;
+};
+#endif
+
+#endif // !UUID_FORMAT_HPP
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef UUID_GUID_HPP
+#define UUID_GUID_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace uuid
+{
+    // position in canonical order of each byte in Microsoft GUID order,
+    // Data1, Data2 and Data3 are stored little-endian, Data4 as is
+    constexpr std::array<std::size_t, 16> GUID_BYTE_ORDER = { 3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+
+    /// @brief Returns the bytes of an UUID as stored by a Microsoft GUID.
+    ///
+    /// The layout of GUID in memory on Windows, of System.Guid.ToByteArray()
+    /// in .NET and of uniqueidentifier columns in SQL Server.
+    ///
+    [[nodiscard]] constexpr std::array<std::byte, 16> to_guid_bytes(const Uuid& u) noexcept
+    {
+        std::array<std::byte, 16> bytes{};
+        for (std::size_t i = 0; i < std::size(bytes); ++i)
+            bytes[i] = u.data()[GUID_BYTE_ORDER[i]];
+        return bytes;
+    }
+
+    /// @brief Constructs an UUID from the bytes of a Microsoft GUID.
+    [[nodiscard]] constexpr Uuid from_guid_bytes(std::span<const std::byte, 16> bytes) noexcept
+    {
+        // the permutation is its own inverse
+        std::array<std::byte, 16> canonical{};
+        for (std::size_t i = 0; i < std::size(canonical); ++i)
+            canonical[i] = bytes[GUID_BYTE_ORDER[i]];
+        return Uuid{ canonical };
+    }
+
+    /// @brief Converts many UUIDs in place between canonical and GUID byte order.
+    ///
+    /// The conversion goes both ways, as it swaps the same bytes.
+    ///
+    void swap_guid_order(std::span<Uuid> uuids) noexcept;
+
+
+    /// @brief Orders UUIDs as SQL Server orders uniqueidentifier values.
+    ///
+    /// Compares the node bytes first, then the clock sequence, then the
+    /// timestamp from its least significant byte: canonical bytes 10 to 15,
+    /// 8, 9, then 7 down to 0. Sorting a bulk load by this order makes it
+    /// append to the index instead of splitting pages.
+    ///
+    struct SqlServerLess
+    {
+        [[nodiscard]] constexpr bool operator()(const Uuid& lhs, const Uuid& rhs) const noexcept
+        {
+            return _key(lhs) < _key(rhs);
+        }
+
+        // the bytes packed as two integers that compare in the same order,
+        // written so that compilers turn the loops into plain and byte-swapped loads
+        [[nodiscard]] static constexpr std::array<std::uint64_t, 2> _key(const Uuid& u) noexcept
+        {
+            std::uint64_t hi = 0;
+            std::uint64_t lo = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                hi = (hi << 8) | std::to_integer<std::uint64_t>(u.data()[8 + i]);
+                lo |= std::to_integer<std::uint64_t>(u.data()[i]) << (8 * i);
+            }
+            // bytes 8 and 9 follow the node
+            return { std::rotl(hi, 16), lo };
+        }
+    };
+
+} // namespace uuid
+
+#endif // !UUID_GUID_HPP
@@ -0,0 +1,146 @@
+#pragma once
+#ifndef UUID_INDEX_HPP
+#define UUID_INDEX_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+#include "uuid-cpp/uuid_range.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace uuid
+{
+    // keys in a leaf of UuidIndex, separators in an inner node
+    constexpr std::size_t INDEX_NODE_SLOTS = 64;
+
+    struct _index_key;
+    struct _index_node;
+    struct _index_leaf;
+    struct _index_inner;
+    struct _index_path;
+
+    /// @brief Ordered set of UUIDs for concurrent use.
+    ///
+    /// A B+ tree with optimistic lock coupling [Leis et al. 2016]: each node
+    /// has a version word, readers never write to shared memory and restart if
+    /// a version they went through changed, writers lock only the nodes they
+    /// modify. Keys are stored as two 64 bits words in separate arrays, so that
+    /// searches mostly compare the upper halves. Lookups and scans are lock free,
+    /// inserts and erases of keys in different leaves run in parallel.
+    ///
+    /// Nodes are never merged. A leaf left empty by an erase is unlinked from
+    /// the tree, together with the inner nodes that had it as their only child.
+    /// Unlinked nodes are kept for reuse by later splits and released with the
+    /// index, so that a reader that still holds one only sees a changed version.
+    /// Memory therefore follows the peak number of nodes: keys that are inserted
+    /// in order and expired from the bottom, as time-ordered UUIDs, keep it steady.
+    ///
+    class UuidIndex
+    {
+    public:
+        /// @brief Constructs an empty index.
+        UuidIndex();
+        ~UuidIndex();
+
+        UuidIndex(const UuidIndex&) = delete;
+        UuidIndex& operator=(const UuidIndex&) = delete;
+
+        /// @brief Adds an UUID, returns false if it was already there.
+        bool insert(const Uuid& u);
+
+        /// @brief Removes an UUID, returns false if it wasn't there.
+        bool erase(const Uuid& u);
+
+        /// @brief Checks whether an UUID is in the index.
+        [[nodiscard]] bool contains(const Uuid& u) const noexcept;
+
+        /// @brief Returns the number of UUIDs, concurrent changes might not be counted yet.
+        [[nodiscard]] std::size_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        /// @brief Calls f on the UUIDs between first and last, both included, in order.
+        ///
+        /// Each leaf is copied out and validated before f sees its UUIDs, so f
+        /// can modify the index, for instance erase the UUIDs it visits. UUIDs
+        /// inserted or erased during the scan might or might not be visited.
+        ///
+        template <typename F>
+        void for_each(const Uuid& first, const Uuid& last, F&& f) const
+        {
+            if (last < first)
+                return;
+
+            std::array<Uuid, INDEX_NODE_SLOTS> batch;
+            auto from = first;
+            for (bool more = true; more;)
+            {
+                std::size_t count = 0;
+                more              = _collect(from, last, batch, count);
+                for (std::size_t i = 0; i < count; ++i)
+                    f(batch[i]);
+            }
+        }
+
+        /// @brief Calls f on all the UUIDs, in order.
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            std::array<std::byte, 16> ones;
+            ones.fill(std::byte{ 0xff });
+            for_each(Uuid{}, Uuid{ ones }, f);
+        }
+
+        /// @brief Calls f on the UUIDs generated between two points in time, both included, in order.
+        ///
+        /// The UUIDs of a time-ordered version sort by timestamp, so the range is
+        /// contiguous and the scan only searches in the first and last leaves.
+        /// Throws std::invalid_argument for versions that aren't time-ordered.
+        ///
+        template <typename F>
+        void for_each_in_time(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to,
+            F&& f, std::uint8_t version = 7) const
+        {
+            if (to < from)
+                return;
+            for_each(min_for_time(from, version), max_for_time(to, version), f);
+        }
+
+    private:
+        // copies out the UUIDs of the leaf holding from, up to last, and moves from to
+        // the start of the next leaf; returns false when no later leaf is in range
+        [[nodiscard]] bool _collect(Uuid& from, const Uuid& last, std::span<Uuid, INDEX_NODE_SLOTS> out,
+            std::size_t& count) const noexcept;
+
+        // splits the node at the given level of the path, unless it changed since;
+        // returns false when the locks were lost to another writer
+        bool _split(const _index_path& path, std::size_t level, const Uuid& u);
+
+        // removes the leaf of an erased key from the tree, if it is still empty
+        void _unlink_empty(_index_key key);
+
+        [[nodiscard]] _index_leaf*  _new_leaf();
+        [[nodiscard]] _index_inner* _new_inner();
+        void                        _recycle(_index_node* node);
+
+        std::atomic<_index_node*> _root;
+        std::atomic<std::size_t>  _size{ 0 };
+
+        // every node ever allocated, and the unlinked ones ready for reuse
+        std::mutex                                 _nodes_mutex;
+        std::vector<std::unique_ptr<_index_leaf>>  _leaves;
+        std::vector<std::unique_ptr<_index_inner>> _inners;
+        std::vector<_index_leaf*>                  _free_leaves;
+        std::vector<_index_inner*>                 _free_inners;
+    };
+
+} // namespace uuid
+
+#endif // !UUID_INDEX_HPP
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef UUID_INTERNER_HPP
+#define UUID_INTERNER_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace uuid
+{
+    /// @brief Maps UUIDs to dense 32 bits handles.
+    ///
+    /// Handles are assigned in insertion order starting from 0, so that they
+    /// can index plain arrays. The UUIDs are stored contiguously by handle.
+    /// Inserts are thread safe: the lookup table is split in stripes, each
+    /// one guarded by its own lock and selected by the high bits of the hash.
+    ///
+    /// The storage is allocated up front for the given capacity and never moves,
+    /// so reverse lookups don't need any lock. Pages are only touched as handles
+    /// are assigned.
+    ///
+    class Interner
+    {
+    public:
+        using handle_type = std::uint32_t;
+
+        // marks an unused slot of the lookup table
+        static constexpr handle_type INVALID_HANDLE = std::numeric_limits<handle_type>::max();
+
+        /// @brief Constructs an empty interner.
+        /// @param capacity Maximum number of distinct UUIDs, 16 bytes each are reserved up front.
+        ///
+        /// Throws std::invalid_argument if the capacity exceeds the range of handles.
+        ///
+        explicit Interner(std::size_t capacity = std::size_t{ 1 } << 16);
+
+        Interner(const Interner&) = delete;
+        Interner& operator=(const Interner&) = delete;
+
+        /// @brief Returns the handle of an UUID, assigning a new one if needed.
+        ///
+        /// Throws std::length_error if the interner is full.
+        ///
+        [[nodiscard]] handle_type intern(const Uuid& u);
+
+        /// @brief Interns many UUIDs, each stripe is locked only once.
+        ///
+        /// out[i] receives the handle of in[i].
+        /// Throws std::length_error if the interner gets full.
+        ///
+        void intern_many(std::span<const Uuid> in, std::span<handle_type> out);
+
+        /// @brief Returns the handle of an UUID, if already interned.
+        [[nodiscard]] std::optional<handle_type> find(const Uuid& u) const;
+
+        /// @brief Returns the UUID with the given handle.
+        [[nodiscard]] const Uuid& operator[](handle_type h) const noexcept
+        {
+            assert(h < size());
+            return _values[h];
+        }
+
+        /// @brief Returns all the interned UUIDs, indexed by handle.
+        ///
+        /// Handles assigned by concurrent inserts might not be visible yet.
+        ///
+        [[nodiscard]] std::span<const Uuid> values() const noexcept
+        {
+            return { _values.get(), size() };
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return _committed.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return _capacity; }
+
+    private:
+        struct _slot
+        {
+            std::uint32_t tag; // upper bits of the hash, avoids most loads from the values
+            handle_type   handle;
+        };
+
+        struct alignas(64) _stripe
+        {
+            mutable std::mutex mtx;
+            std::vector<_slot> table;
+            std::size_t        count = 0;
+        };
+
+        static constexpr std::size_t STRIPE_COUNT_LOG2 = 6;
+        static constexpr std::size_t STRIPE_COUNT      = std::size_t{ 1 } << STRIPE_COUNT_LOG2;
+
+        [[nodiscard]] static std::size_t _checked_capacity(std::size_t capacity);
+        [[nodiscard]] static std::size_t _hash(const Uuid& u) noexcept { return std::hash<Uuid>{}(u); }
+        [[nodiscard]] static std::size_t _stripe_of(std::size_t hash) noexcept
+        {
+            return hash >> (std::numeric_limits<std::size_t>::digits - STRIPE_COUNT_LOG2);
+        }
+
+        [[nodiscard]] handle_type _insert(_stripe& s, const Uuid& u, std::size_t hash);
+        [[nodiscard]] std::size_t _probe(const _stripe& s, const Uuid& u, std::size_t hash) const noexcept;
+        void                      _grow(_stripe& s);
+
+        std::unique_ptr<Uuid[]>           _values;
+        const std::size_t                 _capacity;
+        std::atomic<std::size_t>          _next{ 0 };      // next handle to assign
+        std::atomic<std::size_t>          _committed{ 0 }; // handles below have their UUID stored
+        std::array<_stripe, STRIPE_COUNT> _stripes;
+    };
+
+} // namespace uuid
+
+#endif // !UUID_INTERNER_HPP
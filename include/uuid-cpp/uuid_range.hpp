@@ -0,0 +1,313 @@
+#pragma once
+#ifndef UUID_RANGE_HPP
+#define UUID_RANGE_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+
+namespace uuid
+{
+    // largest value of the 60 bits time and sequence field of time-ordered UUIDs
+    constexpr std::uint64_t _TIME_ORDERED_VALUE_MAX = (std::uint64_t{ 1 } << 60) - 1;
+
+    // sets the [RFC 4122] variant in the most significant bits of the lower half
+    [[nodiscard]] constexpr std::uint64_t _with_variant(std::uint64_t tail) noexcept
+    {
+        return (tail & 0x3fff'ffff'ffff'ffff) | 0x8000'0000'0000'0000;
+    }
+
+    // converts nanoseconds since the Unix epoch to a version 1 timestamp, also used by version 6
+    [[nodiscard]] constexpr std::uint64_t _version_1_timestamp(std::uint64_t unix_ns) noexcept
+    {
+        // [RFC 4122 4.1.4 Timestamp]
+        // For UUID version 1, this is represented by Coordinated Universal Time(UTC)
+        // as a count of 100 - nanosecond intervals since 00 : 00 : 00.00, 15 October 1582
+        // (the date of Gregorian reform to the Christian calendar)
+        constexpr std::uint64_t GREGORIAN_TO_UNIX_OFFSET = 0x01b2'1dd2'1381'4000;
+        return unix_ns / 100 + GREGORIAN_TO_UNIX_OFFSET;
+    }
+
+    // converts nanoseconds since the Unix epoch to a version 7 time and counter value
+    [[nodiscard]] constexpr std::uint64_t _version_7_timestamp(std::uint64_t unix_ns) noexcept
+    {
+        // 48 bits of milliseconds followed by 12 bits of counter, starting from zero
+        return (unix_ns / 1'000'000) << 12;
+    }
+
+    /// @brief Builds a time-ordered UUID, version 6 or 7.
+    ///
+    /// The 60 bits of time and sequence are stored most significant first,
+    /// so that UUIDs sort by creation time, and the version takes the high
+    /// nibble of byte 6 without overlapping them. The lower half carries
+    /// the variant and node (or random) bits.
+    ///
+    [[nodiscard]] constexpr Uuid _build_time_ordered(
+        std::uint8_t version, std::uint64_t value, std::uint64_t tail) noexcept
+    {
+        std::array<std::byte, 16> bytes{};
+        for (std::size_t i = 0; i < 6; ++i)
+            bytes[i] = static_cast<std::byte>(value >> (12 + (5 - i) * 8));
+        bytes[6] = static_cast<std::byte>((version << 4) | ((value >> 8) & 0x0f));
+        bytes[7] = static_cast<std::byte>(value);
+
+        for (std::size_t i = 0; i < 8; ++i)
+            bytes[8 + i] = static_cast<std::byte>(tail >> ((7 - i) * 8));
+
+        return Uuid{ bytes };
+    }
+
+    /// @brief Builds a time-based UUID, version 1, 6 or 7.
+    ///
+    /// Version 1 stores the same 60 bits least significant first, as
+    /// time_low | time_mid | time_hi_and_version [RFC 4122 4.1.2], so its
+    /// UUIDs don't sort by creation time.
+    ///
+    [[nodiscard]] constexpr Uuid _build_time_based(
+        std::uint8_t version, std::uint64_t value, std::uint64_t tail) noexcept
+    {
+        if (version != 1)
+            return _build_time_ordered(version, value, tail);
+
+        std::array<std::byte, 16> bytes{};
+        for (std::size_t i = 0; i < 4; ++i)
+            bytes[i] = static_cast<std::byte>(value >> ((3 - i) * 8));
+        bytes[4] = static_cast<std::byte>(value >> 40);
+        bytes[5] = static_cast<std::byte>(value >> 32);
+        bytes[6] = static_cast<std::byte>((version << 4) | ((value >> 56) & 0x0f));
+        bytes[7] = static_cast<std::byte>(value >> 48);
+
+        for (std::size_t i = 0; i < 8; ++i)
+            bytes[8 + i] = static_cast<std::byte>(tail >> ((7 - i) * 8));
+
+        return Uuid{ bytes };
+    }
+
+
+    /// @brief Contiguous block of time-based UUIDs reserved from an engine.
+    ///
+    /// UUIDs are computed on the fly from the first value of the block,
+    /// iterating doesn't touch the state of the engine that made the reservation.
+    /// The UUIDs of version 6 and 7 ranges are sorted, those of version 1 only unique.
+    /// Ranges can be serialized to be leased to other processes.
+    ///
+    class UuidRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Uuid;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = void;
+            using reference         = Uuid;
+
+            constexpr iterator() noexcept = default;
+
+            [[nodiscard]] constexpr Uuid operator*() const noexcept
+            {
+                return _build_time_based(_version, _value, _tail);
+            }
+
+            constexpr iterator& operator++() noexcept
+            {
+                ++_value;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept
+            {
+                auto old = *this;
+                ++_value;
+                return old;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept
+            {
+                return _value == other._value;
+            }
+
+        private:
+            friend class UuidRange;
+
+            constexpr iterator(std::uint8_t version, std::uint64_t value, std::uint64_t tail) noexcept
+                : _version{ version }
+                , _value{ value }
+                , _tail{ tail }
+            {
+            }
+
+            std::uint8_t  _version = 0;
+            std::uint64_t _value   = 0;
+            std::uint64_t _tail    = 0;
+        };
+
+        // lenght of a range in serialized form
+        static constexpr std::size_t SERIALIZED_SIZE = 3 * sizeof(std::uint64_t);
+
+        /// @brief Constructs an empty range.
+        constexpr UuidRange() noexcept = default;
+
+        /// @brief Constructs the range of count UUIDs starting from the given time and sequence value.
+        constexpr UuidRange(std::uint8_t version, std::uint64_t first, std::uint64_t count, std::uint64_t tail) noexcept
+            : _version{ version }
+            , _first{ first }
+            , _count{ count }
+            , _tail{ _with_variant(tail) }
+        {
+            assert(first <= _TIME_ORDERED_VALUE_MAX && count <= _TIME_ORDERED_VALUE_MAX - first + 1);
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return static_cast<std::size_t>(_count); }
+        [[nodiscard]] constexpr bool        empty() const noexcept { return _count == 0; }
+
+        [[nodiscard]] constexpr Uuid operator[](std::size_t i) const noexcept
+        {
+            assert(i < _count);
+            return _build_time_based(_version, _first + i, _tail);
+        }
+
+        [[nodiscard]] constexpr Uuid front() const noexcept { return (*this)[0]; }
+        [[nodiscard]] constexpr Uuid back() const noexcept { return (*this)[size() - 1]; }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept { return { _version, _first, _tail }; }
+        [[nodiscard]] constexpr iterator end() const noexcept { return { _version, _first + _count, _tail }; }
+
+        /// @brief Writes the range in a portable, fixed size, form.
+        ///
+        /// Layout: version and first value | count | variant and node bits,
+        /// as 64 bits big endian words.
+        ///
+        constexpr void serialize(std::span<std::byte, SERIALIZED_SIZE> out) const noexcept
+        {
+            const std::uint64_t words[] = { (std::uint64_t{ _version } << 60) | _first, _count, _tail };
+            for (std::size_t w = 0; w < std::size(words); ++w)
+                for (std::size_t i = 0; i < 8; ++i)
+                    out[w * 8 + i] = static_cast<std::byte>(words[w] >> ((7 - i) * 8));
+        }
+
+        /// @brief Reads a range written by serialize().
+        [[nodiscard]] static constexpr UuidRange deserialize(std::span<const std::byte, SERIALIZED_SIZE> in)
+        {
+            std::uint64_t words[3] = {};
+            for (std::size_t w = 0; w < std::size(words); ++w)
+                for (std::size_t i = 0; i < 8; ++i)
+                    words[w] = (words[w] << 8) | std::to_integer<std::uint64_t>(in[w * 8 + i]);
+
+            const auto version = static_cast<std::uint8_t>(words[0] >> 60);
+            const auto first   = words[0] & _TIME_ORDERED_VALUE_MAX;
+            const auto count   = words[1];
+            const auto tail    = words[2];
+
+            if (version != 1 && version != 6 && version != 7)
+                throw std::invalid_argument{ "Invalid version of time-based range" };
+            if (count > _TIME_ORDERED_VALUE_MAX - first + 1)
+                throw std::invalid_argument{ "Invalid lenght of time-ordered range" };
+            if (tail != _with_variant(tail))
+                throw std::invalid_argument{ "Invalid variant of time-ordered range" };
+
+            return UuidRange{ version, first, count, tail };
+        }
+
+        [[nodiscard]] constexpr bool operator==(const UuidRange&) const noexcept = default;
+
+    private:
+        std::uint8_t  _version = 0;
+        std::uint64_t _first   = 0;
+        std::uint64_t _count   = 0;
+        std::uint64_t _tail    = 0;
+    };
+
+
+    // 60 bits time value of the first UUID a time-ordered engine can generate at the given time
+    [[nodiscard]] constexpr std::uint64_t _time_ordered_value(std::chrono::system_clock::time_point t, std::uint8_t version)
+    {
+        using namespace std::chrono;
+        const auto ns      = duration_cast<nanoseconds>(t.time_since_epoch()).count();
+        const auto unix_ns = static_cast<std::uint64_t>(std::max<decltype(ns)>(ns, 0)); // clamped to the epoch
+
+        switch (version)
+        {
+        case 6:
+            return _version_1_timestamp(unix_ns);
+        case 7:
+            return _version_7_timestamp(unix_ns);
+        default:
+            throw std::invalid_argument{ "Not a time-ordered UUID version" };
+        }
+    }
+
+    /// @brief Returns the smallest UUID of the given version with a timestamp not earlier than t.
+    ///
+    /// Version 6 counts intervals of 100 ns, version 7 milliseconds.
+    /// Throws std::invalid_argument for other versions, version 1 included
+    /// as its UUIDs don't sort by time.
+    ///
+    [[nodiscard]] constexpr Uuid min_for_time(std::chrono::system_clock::time_point t, std::uint8_t version = 7)
+    {
+        return _build_time_ordered(version, _time_ordered_value(t, version), 0);
+    }
+
+    /// @brief Returns the largest UUID of the given version with the same timestamp as t.
+    ///
+    /// Version 6 counts intervals of 100 ns, version 7 milliseconds.
+    /// Throws std::invalid_argument for other versions, version 1 included
+    /// as its UUIDs don't sort by time.
+    ///
+    [[nodiscard]] constexpr Uuid max_for_time(std::chrono::system_clock::time_point t, std::uint8_t version = 7)
+    {
+        // the 12 bits counter of version 7 follows the milliseconds
+        const auto value = _time_ordered_value(t, version) | (version == 7 ? 0x0fff : 0);
+        return _build_time_ordered(version, value, ~std::uint64_t{ 0 });
+    }
+
+    // index of the first UUID whose upper half isn't below the key (or above it if upper)
+    [[nodiscard]] constexpr std::size_t _search_high_word(std::span<const Uuid> sorted, std::uint64_t key, bool upper) noexcept
+    {
+        if (sorted.empty())
+            return 0;
+
+        // halving without branches on the data, so that comparisons compile to conditional moves
+        const Uuid* base = std::data(sorted);
+        std::size_t n    = std::size(sorted);
+        while (n > 1)
+        {
+            const auto half = n / 2;
+            const auto word = _big_endian_half(base[half - 1], 0);
+            base            = (upper ? word <= key : word < key) ? base + half : base;
+            n -= half;
+        }
+        const auto word = _big_endian_half(*base, 0);
+        return static_cast<std::size_t>(base - std::data(sorted)) + ((upper ? word <= key : word < key) ? 1 : 0);
+    }
+
+    /// @brief Returns the UUIDs generated between two points in time, both included.
+    ///
+    /// The UUIDs must be sorted and of the given time-ordered version, 6 or 7,
+    /// timestamps are compared at the precision of the version. Boundaries only depend on
+    /// the upper half of the UUIDs, the search only reads that half.
+    /// Throws std::invalid_argument for versions that aren't time-ordered.
+    ///
+    [[nodiscard]] constexpr std::span<const Uuid> time_range(std::span<const Uuid> sorted,
+        std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to, std::uint8_t version = 7)
+    {
+        if (to < from)
+            return {};
+
+        const auto first = _search_high_word(sorted, _big_endian_half(min_for_time(from, version), 0), false);
+        const auto last  = _search_high_word(sorted, _big_endian_half(max_for_time(to, version), 0), true);
+        return sorted.subspan(first, last - first);
+    }
+
+} // namespace uuid
+
+#endif // !UUID_RANGE_HPP
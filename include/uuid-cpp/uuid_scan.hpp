@@ -0,0 +1,85 @@
+#pragma once
+#ifndef UUID_SCAN_HPP
+#define UUID_SCAN_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+namespace uuid
+{
+    // read-only view of a whole file, memory mapped where supported
+    class _mapped_file
+    {
+    public:
+        explicit _mapped_file(const std::filesystem::path& path);
+        ~_mapped_file();
+
+        _mapped_file(const _mapped_file&) = delete;
+        _mapped_file& operator=(const _mapped_file&) = delete;
+
+        [[nodiscard]] std::string_view text() const noexcept { return { _data, _size }; }
+
+    private:
+        const char*             _data = nullptr;
+        std::size_t             _size = 0;
+        std::unique_ptr<char[]> _copy; // contents read in memory, without mappings
+    };
+
+    // type erased callback of the scanners, invoked with the match and its offset in the text
+    using _scan_callback = void (*)(void* context, const Uuid& u, std::size_t offset);
+
+    std::size_t _scan(std::string_view text, _scan_callback callback, void* context);
+    std::size_t _scan_file(const std::filesystem::path& path, _scan_callback callback, void* context);
+
+    template <typename F>
+    void _scan_thunk(void* context, const Uuid& u, std::size_t offset)
+    {
+        auto& f = *static_cast<F*>(context);
+        if constexpr (std::is_invocable_v<F&, const Uuid&, std::size_t>)
+            f(u, offset);
+        else
+            f(u);
+    }
+
+    template <typename F>
+    concept _scan_visitor = std::is_invocable_v<F&, const Uuid&, std::size_t> || std::is_invocable_v<F&, const Uuid&>;
+
+
+    /// @brief Finds all the UUIDs in canonical form inside a text.
+    ///
+    /// Matches are 36 characters long, with hyphens at offsets 8, 13, 18 and 23
+    /// and hexadecimal digits of either case elsewhere. They are reported from
+    /// left to right and never overlap. A match can't be preceded or followed by
+    /// another hexadecimal digit, so that pieces of longer hex strings are skipped.
+    ///
+    /// @param callback Invoked as callback(uuid, offset) or callback(uuid).
+    /// @return The number of matches.
+    ///
+    template <_scan_visitor F>
+    std::size_t for_each_uuid(std::string_view text, F&& callback)
+    {
+        using _f = std::remove_reference_t<F>;
+        return _scan(text, &_scan_thunk<_f>, const_cast<void*>(static_cast<const void*>(std::addressof(callback))));
+    }
+
+    /// @brief Finds all the UUIDs in canonical form inside a file.
+    ///
+    /// The file is memory mapped and scanned as for_each_uuid(), offsets
+    /// are relative to the start of the file.
+    /// Throws std::system_error if the file can't be opened or mapped.
+    ///
+    template <_scan_visitor F>
+    std::size_t for_each_uuid_in_file(const std::filesystem::path& path, F&& callback)
+    {
+        using _f = std::remove_reference_t<F>;
+        return _scan_file(path, &_scan_thunk<_f>, const_cast<void*>(static_cast<const void*>(std::addressof(callback))));
+    }
+
+} // namespace uuid
+
+#endif // !UUID_SCAN_HPP
@@ -0,0 +1,163 @@
+#pragma once
+#ifndef UUID_SERVICE_HPP
+#define UUID_SERVICE_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace uuid
+{
+    /// @brief Pre-generates UUIDs on a background thread.
+    ///
+    /// UUIDs are buffered in a lock-free ring, so that request threads never
+    /// pay for the latency of the engine (syscalls, adapters enumeration, ...).
+    /// The ring is refilled as soon as it drains under the low-water mark.
+    ///
+    /// UUIDs generated before reseed_engines() are dropped. The service doesn't
+    /// survive a fork: the child has no service thread and a copy of the ring
+    /// of the parent, so it hands out nothing instead, pop() throws and
+    /// try_pop() comes back empty. Children must start their own service.
+    ///
+    class GeneratorService
+    {
+    public:
+        class _pop_awaiter;
+
+        /// @brief Starts the service.
+        /// @param engine    Source of UUIDs, only ever invoked by the service thread.
+        /// @param capacity  Size of the ring, rounded up to a power of two (at least 128).
+        /// @param low_water Refill threshold, defaults to a quarter of the capacity.
+        ///
+        template <typename Engine>
+        explicit GeneratorService(Engine engine, std::size_t capacity = 4096, std::size_t low_water = 0)
+            : GeneratorService{ std::function<void(std::span<Uuid>)>{ [engine = std::move(engine)](std::span<Uuid> out) mutable {
+                                    for (auto& u : out)
+                                        u = engine();
+                                } },
+                capacity, low_water }
+        {
+        }
+
+        explicit GeneratorService(std::function<void(std::span<Uuid>)> fill, std::size_t capacity, std::size_t low_water);
+
+        /// @brief Stops the service, pending waiters get an exception.
+        ~GeneratorService();
+
+        GeneratorService(const GeneratorService&) = delete;
+        GeneratorService& operator=(const GeneratorService&) = delete;
+
+        /// @brief Takes an UUID, blocks while the ring is empty.
+        ///
+        /// Rethrows the exception thrown by the engine, if any.
+        /// Throws std::runtime_error in a forked child.
+        ///
+        [[nodiscard]] Uuid pop();
+
+        /// @brief Takes an UUID if one is immediately available.
+        [[nodiscard]] std::optional<Uuid> try_pop() noexcept;
+
+        /// @brief Takes an UUID, suspends the calling coroutine while the ring is empty.
+        ///
+        /// Suspended coroutines are resumed on the service thread.
+        ///
+        [[nodiscard]] _pop_awaiter async_pop() noexcept;
+
+        /// @brief Returns the approximate number of buffered UUIDs.
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return _mask + 1; }
+
+
+        class _pop_awaiter
+        {
+        public:
+            [[nodiscard]] bool await_ready() noexcept
+            {
+                _value = _service->try_pop();
+                return _value.has_value();
+            }
+
+            [[nodiscard]] bool await_suspend(std::coroutine_handle<> h)
+            {
+                return _service->_suspend(*this, h);
+            }
+
+            [[nodiscard]] Uuid await_resume()
+            {
+                if (!_value)
+                    _service->_rethrow();
+                return *_value;
+            }
+
+        private:
+            friend class GeneratorService;
+
+            explicit _pop_awaiter(GeneratorService* service) noexcept
+                : _service{ service }
+            {
+            }
+
+            GeneratorService*       _service;
+            std::optional<Uuid>     _value;
+            std::coroutine_handle<> _handle;
+        };
+
+    private:
+        struct _cell
+        {
+            std::atomic<std::size_t> sequence;
+            Uuid                     value;
+            std::uint32_t            generation; // reseed generation when the value was drawn
+        };
+
+        void _run() noexcept;
+        void _fill();
+        void _resume_waiters();
+        void _request_refill() noexcept;
+        bool _push(const Uuid& u, std::uint32_t generation) noexcept;
+
+        // true in a child forked after the service started
+        [[nodiscard]] bool _forked() noexcept;
+
+        [[nodiscard]] bool _suspend(_pop_awaiter& awaiter, std::coroutine_handle<> h);
+        [[noreturn]] void  _rethrow() const;
+
+        std::function<void(std::span<Uuid>)> _generate;
+
+        std::unique_ptr<_cell[]> _ring;
+        const std::size_t        _mask;
+        const std::size_t        _low_water;
+
+        alignas(64) std::atomic<std::size_t> _head{ 0 }; // next slot to pop, shared by consumers
+        alignas(64) std::atomic<std::size_t> _tail{ 0 }; // next slot to push, owned by the service thread
+
+        std::atomic<bool>          _refill_requested{ true };
+        std::atomic<std::uint32_t> _available{ 0 }; // bumped after each refill, blocking pops wait on it
+        std::atomic<bool>          _stopping{ false };
+        std::exception_ptr         _error; // published by _stopping
+
+        std::mutex                 _waiters_mtx;
+        std::vector<_pop_awaiter*> _waiters;
+
+        const long                 _owner;               // process that runs the service thread
+        std::atomic<std::uint32_t> _owner_generation;    // last reseed generation seen in that process
+
+        std::unique_ptr<std::thread> _thread; // released without joining in forked children
+    };
+
+} // namespace uuid
+
+#endif // !UUID_SERVICE_HPP
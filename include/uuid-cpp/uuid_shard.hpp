@@ -0,0 +1,85 @@
+#pragma once
+#ifndef UUID_SHARD_HPP
+#define UUID_SHARD_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace uuid
+{
+    /// @brief How UUIDs are mapped to shards.
+    enum class ShardMethod
+    {
+        /// Jump consistent hash [Lamping, Veach 2014]. When the number of
+        /// shards grows from n to n + 1, only the keys moving to the new
+        /// shard change, about 1 / (n + 1) of them.
+        jump,
+
+        /// Multiply and shift reduction [Lemire 2016]. Constant time, but
+        /// most keys change shard whenever the number of shards changes.
+        fast_range,
+    };
+
+
+    /// @brief 64 bits key of an UUID, uniform for all versions.
+    ///
+    /// The UUIDs of a time-based engine share their node and the high bits of
+    /// their timestamp, only a few low bits of time and counter tell them apart.
+    /// Both halves therefore go through the MurmurHash3 finalizer, read most
+    /// significant first so that shards don't depend on the byte order of the host.
+    ///
+    [[nodiscard]] constexpr std::uint64_t _shard_key(const Uuid& u) noexcept
+    {
+        return _fmix64(_big_endian_half(u, 0) ^ _fmix64(_big_endian_half(u, 8)));
+    }
+
+    [[nodiscard]] constexpr std::uint32_t _jump_hash(std::uint64_t key, std::uint32_t n) noexcept
+    {
+        std::int64_t b = -1;
+        std::int64_t j = 0;
+        while (j < static_cast<std::int64_t>(n))
+        {
+            b   = j;
+            key = key * 2862933555777941757ull + 1;
+            j   = static_cast<std::int64_t>(
+                static_cast<double>(b + 1) * (static_cast<double>(1ll << 31) / static_cast<double>((key >> 33) + 1)));
+        }
+        return static_cast<std::uint32_t>(b);
+    }
+
+    /// @brief Returns the shard of an UUID, out of n > 0.
+    [[nodiscard]] constexpr std::uint32_t shard(const Uuid& u, std::uint32_t n, ShardMethod method = ShardMethod::jump) noexcept
+    {
+        assert(n > 0);
+        const auto key = _shard_key(u);
+        if (method == ShardMethod::fast_range)
+            return static_cast<std::uint32_t>(((key >> 32) * n) >> 32);
+        return _jump_hash(key, n);
+    }
+
+    /// @brief Computes the shards of many UUIDs.
+    ///
+    /// shard_out[i] receives shard(in[i], n, method).
+    ///
+    void shard_many(std::span<const Uuid> in, std::uint32_t n, std::span<std::uint32_t> shard_out,
+        ShardMethod method = ShardMethod::jump) noexcept;
+
+    /// @brief Reorders UUIDs so that each shard is a contiguous run.
+    ///
+    /// Runs are sorted by shard, UUIDs inside a run are in no particular
+    /// order. The work is done in place, with an extra 4 bytes per UUID.
+    /// Throws std::invalid_argument if n is zero.
+    ///
+    /// @return n + 1 offsets, the run of shard s is [offsets[s], offsets[s + 1]).
+    ///
+    [[nodiscard]] std::vector<std::size_t> partition(
+        std::span<Uuid> uuids, std::uint32_t n, ShardMethod method = ShardMethod::jump);
+
+} // namespace uuid
+
+#endif // !UUID_SHARD_HPP
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef UUID_SHARED_HPP
+#define UUID_SHARED_HPP
+
+#include "uuid-cpp/uuid_engine.hpp"
+#include "uuid-cpp/uuid_stats.hpp"
+#include "uuid-cpp/uuid_time.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace uuid
+{
+    // layout of the shared memory segment
+    struct _shared_sequence_block
+    {
+        std::atomic<std::uint64_t> header; // magic number and version, zero until initialized
+        std::atomic<std::uint64_t> last;   // last value claimed by any process
+    };
+
+    // the values must be updated in place by all processes
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+
+    /// @brief Time and sequence state shared by the engines of all processes on the host.
+    ///
+    /// Lives in a named shared memory segment, created on first use, and is
+    /// updated with a single compare-and-swap per claim. So values never
+    /// repeat across processes and there are no locks that a process could
+    /// die holding: any state left behind by a crash is a valid one.
+    /// A segment only holds values of one UUID version.
+    /// Can be shared between threads and copied, copies refer to the same segment.
+    ///
+    class SharedSequence
+    {
+    public:
+        /// @brief Opens or creates the segment.
+        /// @param name    Name of the segment, like "/myapp-uuid" (see shm_open).
+        /// @param version Version of the UUIDs generated from the segment.
+        ///
+        /// Throws std::system_error if the segment can't be opened or mapped,
+        /// std::invalid_argument if it is used for another version.
+        ///
+        explicit SharedSequence(const std::string& name, std::uint8_t version);
+
+        /// @brief Atomically claims n consecutive values, as _time_sequence::claim().
+        [[nodiscard]] std::uint64_t claim(std::uint64_t now, std::uint64_t n,
+            [[maybe_unused]] EngineKind kind, [[maybe_unused]] unsigned shift) noexcept
+        {
+            std::uint64_t prev;
+            const auto    first = _claim_after(_block->last, now, n, prev);
+            _stats_claim(kind, now, prev, first, n, shift);
+            return first;
+        }
+
+        [[nodiscard]] std::uint8_t version() const noexcept { return _version; }
+
+        /// @brief Removes the segment name, processes that mapped it keep using it.
+        /// @return false if the segment doesn't exist.
+        ///
+        static bool remove(const std::string& name);
+
+    private:
+        std::shared_ptr<_shared_sequence_block> _block; // unmaps the segment with the last copy
+        std::uint8_t                            _version;
+    };
+
+
+    using SharedAddressEngine        = BasicAddressEngine<SystemTimeSource, SharedSequence>;
+    using SharedOrderedAddressEngine = BasicOrderedAddressEngine<SystemTimeSource, SharedSequence>;
+    using SharedTimeEngine           = BasicTimeEngine<SystemTimeSource, SharedSequence>;
+
+} // namespace uuid
+
+#endif // !UUID_SHARED_HPP
@@ -0,0 +1,144 @@
+#pragma once
+#ifndef UUID_STATS_HPP
+#define UUID_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace uuid
+{
+    /// @brief Identifies the engines that report generation statistics.
+    enum class EngineKind : std::uint8_t
+    {
+        address,
+        random,
+        system,
+        time,
+    };
+
+    constexpr std::size_t ENGINE_KIND_COUNT = 4;
+
+    // number of buckets of the latency histograms
+    constexpr std::size_t LATENCY_BUCKET_COUNT = 64;
+
+
+    /// @brief Generation statistics of an engine, aggregated over all threads.
+    struct EngineStats
+    {
+        std::uint64_t generated         = 0; // number of UUIDs produced
+        std::uint64_t clock_backsteps   = 0; // times the clock read behind the last timestamp claimed
+        std::uint64_t counter_overflows = 0; // times the sequence counter ran out of values
+        std::uint64_t entropy_refills   = 0; // times the entropy source was (re)seeded
+
+        /// @brief Latency histogram with logarithmic buckets.
+        ///
+        /// Bucket i counts the calls that took [2^(i-1), 2^i) nanoseconds,
+        /// bucket 0 the ones that took less than a nanosecond.
+        ///
+        std::array<std::uint64_t, LATENCY_BUCKET_COUNT> latency{};
+    };
+
+    /// @brief Checks whether the library was built with statistics enabled.
+    [[nodiscard]] constexpr bool stats_enabled() noexcept
+    {
+#if UUID_CPP_ENABLE_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief Collects the statistics of an engine kind.
+    ///
+    /// Counters are updated with relaxed ordering by the generating threads,
+    /// so the snapshot is not an atomic view across counters.
+    /// Always empty if the library was built without statistics.
+    ///
+    [[nodiscard]] EngineStats stats_snapshot(EngineKind kind) noexcept;
+
+
+
+    // instrumentation hooks for engines, compiled to nothing when disabled
+
+    enum class _stats_counter : std::uint8_t
+    {
+        generated,
+        clock_backsteps,
+        counter_overflows,
+        entropy_refills,
+    };
+
+    constexpr std::size_t _STATS_COUNTER_COUNT = 4;
+
+    // per-thread counters, only ever written by the owning thread
+    struct alignas(64) _stats_block
+    {
+        std::atomic<std::uint64_t> counters[ENGINE_KIND_COUNT][_STATS_COUNTER_COUNT];
+        std::atomic<std::uint64_t> latency[ENGINE_KIND_COUNT][LATENCY_BUCKET_COUNT];
+
+        std::atomic<bool> in_use;
+        _stats_block*     next;
+    };
+
+    // returns the counters of the calling thread
+    [[nodiscard]] _stats_block& _stats_local() noexcept;
+
+    inline void _stats_bump(std::atomic<std::uint64_t>& c, std::uint64_t n = 1) noexcept
+    {
+        // single writer, so a plain load and store is enough and avoids a locked instruction
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    inline void _stats_count([[maybe_unused]] EngineKind kind, [[maybe_unused]] _stats_counter c,
+        [[maybe_unused]] std::uint64_t n = 1) noexcept
+    {
+#if UUID_CPP_ENABLE_STATS
+        _stats_bump(_stats_local().counters[static_cast<std::size_t>(kind)][static_cast<std::size_t>(c)], n);
+#endif
+    }
+
+    // measures a single generation, from construction to destruction
+    class _stats_scope
+    {
+    public:
+        explicit _stats_scope([[maybe_unused]] EngineKind kind) noexcept
+#if UUID_CPP_ENABLE_STATS
+            : _kind{ kind }
+            , _start{ std::chrono::steady_clock::now() }
+#endif
+        {
+        }
+
+        ~_stats_scope() noexcept
+        {
+#if UUID_CPP_ENABLE_STATS
+            using namespace std::chrono;
+            const auto ns     = duration_cast<nanoseconds>(steady_clock::now() - _start).count();
+            const auto bucket = std::min<std::size_t>(
+                std::bit_width(static_cast<std::uint64_t>(ns)), LATENCY_BUCKET_COUNT - 1);
+
+            auto&      block = _stats_local();
+            const auto k     = static_cast<std::size_t>(_kind);
+            _stats_bump(block.counters[k][static_cast<std::size_t>(_stats_counter::generated)]);
+            _stats_bump(block.latency[k][bucket]);
+#endif
+        }
+
+        _stats_scope(const _stats_scope&) = delete;
+        _stats_scope& operator=(const _stats_scope&) = delete;
+
+#if UUID_CPP_ENABLE_STATS
+    private:
+        EngineKind                            _kind;
+        std::chrono::steady_clock::time_point _start;
+#endif
+    };
+
+} // namespace uuid
+
+#endif // !UUID_STATS_HPP
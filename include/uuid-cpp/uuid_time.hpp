@@ -0,0 +1,125 @@
+#pragma once
+#ifndef UUID_TIME_HPP
+#define UUID_TIME_HPP
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+
+namespace uuid
+{
+    /// @brief Source of wall clock timestamps for time-based engines.
+    ///
+    /// Timestamps are expressed in nanoseconds since the Unix epoch.
+    /// Sources are not required to be monotonic nor to have nanosecond resolution,
+    /// engines take care of clock regressions and repeated values.
+    ///
+    template <typename T>
+    concept TimeSource = requires(T& source)
+    {
+        { source.now() } noexcept -> std::convertible_to<std::uint64_t>;
+    };
+
+
+    /// @brief Reads the precise system clock on every call.
+    class SystemTimeSource
+    {
+    public:
+        [[nodiscard]] std::uint64_t now() const noexcept
+        {
+            using namespace std::chrono;
+            return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+        }
+    };
+
+
+    /// @brief Reads the coarse system clock, cheaper but with lower resolution.
+    ///
+    /// Maps to CLOCK_REALTIME_COARSE on Linux, served by the vDSO without
+    /// entering the kernel, and to GetSystemTimeAsFileTime() on Windows.
+    ///
+    class CoarseTimeSource
+    {
+    public:
+        [[nodiscard]] std::uint64_t now() const noexcept;
+    };
+
+
+    /// @brief Loads a timestamp periodically refreshed by a background thread.
+    ///
+    /// Generators only perform a relaxed atomic load.
+    /// All sources built with the same period share the same ticker thread,
+    /// which stops when the last source referencing it is destroyed.
+    ///
+    class TickerTimeSource
+    {
+    public:
+        explicit TickerTimeSource(std::chrono::microseconds period = std::chrono::milliseconds{ 1 });
+
+        [[nodiscard]] std::uint64_t now() const noexcept
+        {
+            return _clock->timestamp.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct _ticker_clock
+        {
+            std::atomic<std::uint64_t> timestamp;
+        };
+        struct _ticker; // owns the background thread
+
+        std::shared_ptr<const _ticker_clock> _clock;
+    };
+
+
+    /// @brief Deterministic clock for testing.
+    ///
+    /// Copies share the same state, so the clock of an engine can still be
+    /// driven after the source has been handed over to it.
+    ///
+    class FakeTimeSource
+    {
+    public:
+        explicit FakeTimeSource(std::uint64_t start = 0, std::uint64_t step = 0)
+            : _state{ std::make_shared<_fake_state>(start, step) }
+        {
+        }
+
+        /// @brief Returns the current time, then advances it by the step.
+        [[nodiscard]] std::uint64_t now() const noexcept
+        {
+            return _state->now.fetch_add(_state->step, std::memory_order_relaxed);
+        }
+
+        /// @brief Sets the current time, backward jumps included.
+        void set(std::uint64_t t) noexcept { _state->now.store(t, std::memory_order_relaxed); }
+
+        /// @brief Moves the current time forward.
+        void advance(std::uint64_t d) noexcept { _state->now.fetch_add(d, std::memory_order_relaxed); }
+
+    private:
+        struct _fake_state
+        {
+            _fake_state(std::uint64_t start, std::uint64_t step) noexcept
+                : now{ start }
+                , step{ step }
+            {
+            }
+
+            std::atomic<std::uint64_t> now;
+            const std::uint64_t        step;
+        };
+
+        std::shared_ptr<_fake_state> _state;
+    };
+
+    static_assert(TimeSource<SystemTimeSource>);
+    static_assert(TimeSource<CoarseTimeSource>);
+    static_assert(TimeSource<TickerTimeSource>);
+    static_assert(TimeSource<FakeTimeSource>);
+
+} // namespace uuid
+
+#endif // !UUID_TIME_HPP
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef UUID_VALIDATE_HPP
+#define UUID_VALIDATE_HPP
+
+#include "uuid-cpp/uuid_core.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace uuid
+{
+    // number of distinct values of the version field
+    constexpr std::size_t UUID_VERSION_COUNT = 16;
+
+    // set of versions defined for the [RFC 4122] variant, 1 to 8, one bit per version
+    constexpr std::uint16_t UUID_RFC_VERSIONS = 0b0000'0001'1111'1110;
+
+    /// @brief Number of UUIDs for each value of the version field.
+    using VersionCounts = std::array<std::size_t, UUID_VERSION_COUNT>;
+
+
+    /// @brief Reads the version of many UUIDs.
+    ///
+    /// version_out[i] receives the version of in[i].
+    /// The variant is not checked, see validate_many().
+    ///
+    /// @return The number of UUIDs of each version.
+    ///
+    VersionCounts classify_many(std::span<const Uuid> in, std::span<std::uint8_t> version_out) noexcept;
+
+    /// @brief Checks the variant and version of many UUIDs.
+    ///
+    /// An UUID is valid if it has the [RFC 4122] variant, and its version
+    /// is one of the allowed ones. Bit i % 64 of invalid_out[i / 64] is set
+    /// if in[i] is invalid, cleared otherwise.
+    ///
+    /// @param allowed_versions Set of accepted versions, one bit per version.
+    /// @return The number of invalid UUIDs.
+    ///
+    std::size_t validate_many(
+        std::span<const Uuid> in, std::uint16_t allowed_versions, std::span<std::uint64_t> invalid_out) noexcept;
+
+} // namespace uuid
+
+#endif // !UUID_VALIDATE_HPP
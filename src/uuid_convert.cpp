@@ -0,0 +1,230 @@
+#include "uuid-cpp/uuid_convert.hpp"
+#include "uuid-cpp/uuid_core.hpp"
+#include "uuid-cpp/uuid_format.hpp"
+#include "uuid-cpp/uuid_scan.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace uuid
+{
+    // lenght of a UUID in canonical ASCII string form (hypens included)
+    constexpr std::size_t CONVERT_TEXT_SIZE = 36;
+
+    // lenght of a UUID in packed binary form
+    constexpr std::size_t CONVERT_RECORD_SIZE = sizeof(Uuid);
+
+    struct _chunk
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct _chunk_result
+    {
+        std::vector<char>         output;
+        std::vector<ConvertError> errors; // lines counted from the start of the chunk
+        std::size_t               lines     = 0;
+        std::size_t               converted = 0;
+        bool                      ready     = false;
+    };
+
+    // splits the input in chunks of about the given size, ending at line or record boundaries
+    [[nodiscard]] std::vector<_chunk> _split(std::string_view input, ConvertDirection direction, std::size_t chunk_size)
+    {
+        std::vector<_chunk> chunks;
+        if (direction == ConvertDirection::binary_to_text)
+            chunk_size = std::max(chunk_size / CONVERT_RECORD_SIZE, std::size_t{ 1 }) * CONVERT_RECORD_SIZE;
+        else
+            chunk_size = std::max(chunk_size, std::size_t{ 1 });
+
+        for (std::size_t begin = 0; begin < std::size(input);)
+        {
+            auto end = std::min(begin + chunk_size, std::size(input));
+            if (direction == ConvertDirection::text_to_binary && end < std::size(input))
+            {
+                // extend to the end of the line
+                const auto nl = input.find('\n', end - 1);
+                end           = (nl == std::string_view::npos) ? std::size(input) : nl + 1;
+            }
+            chunks.push_back({ begin, end });
+            begin = end;
+        }
+        return chunks;
+    }
+
+    [[nodiscard]] _chunk_result _text_to_binary(std::string_view input, _chunk chunk)
+    {
+        _chunk_result result;
+        result.output.reserve((chunk.end - chunk.begin) / (CONVERT_TEXT_SIZE + 1) * CONVERT_RECORD_SIZE);
+
+        for (auto begin = chunk.begin; begin < chunk.end; ++result.lines)
+        {
+            const auto nl  = input.substr(0, chunk.end).find('\n', begin);
+            const auto end = (nl == std::string_view::npos) ? chunk.end : nl;
+
+            auto line = input.substr(begin, end - begin);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            if (!line.empty())
+            {
+                if (const auto u = try_parse(line))
+                {
+                    const auto* bytes = reinterpret_cast<const char*>(u->data());
+                    result.output.insert(std::end(result.output), bytes, bytes + CONVERT_RECORD_SIZE);
+                    ++result.converted;
+                }
+                else
+                    result.errors.push_back({ result.lines, begin });
+            }
+            begin = end + 1;
+        }
+        return result;
+    }
+
+    [[nodiscard]] _chunk_result _binary_to_text(std::string_view input, _chunk chunk)
+    {
+        _chunk_result result;
+        // the formatter takes room for its longest form, slack for the last record
+        result.output.resize((chunk.end - chunk.begin) / CONVERT_RECORD_SIZE * (CONVERT_TEXT_SIZE + 1) +
+                             (UUID_FORMAT_MAX_SIZE - CONVERT_TEXT_SIZE));
+
+        char*       out = std::data(result.output);
+        std::size_t pos = chunk.begin;
+        for (; pos + CONVERT_RECORD_SIZE <= chunk.end; pos += CONVERT_RECORD_SIZE, ++result.lines)
+        {
+            std::array<std::byte, CONVERT_RECORD_SIZE> bytes;
+            std::memcpy(std::data(bytes), std::data(input) + pos, CONVERT_RECORD_SIZE);
+
+            out += _format_to(Uuid{ bytes }, {}, std::span<char, UUID_FORMAT_MAX_SIZE>{ out, UUID_FORMAT_MAX_SIZE });
+            *out++ = '\n';
+            ++result.converted;
+        }
+        result.output.resize(static_cast<std::size_t>(out - std::data(result.output)));
+
+        if (pos != chunk.end) // truncated record at the end of the input
+        {
+            result.errors.push_back({ result.lines, pos });
+            ++result.lines;
+        }
+        return result;
+    }
+
+    ConvertResult convert_file(const std::filesystem::path& in, const std::filesystem::path& out,
+        ConvertDirection direction, const ConvertOptions& options)
+    {
+        const _mapped_file input{ in };
+        const auto         text = input.text();
+
+        std::ofstream os;
+        os.exceptions(std::ios::failbit | std::ios::badbit);
+        os.open(out, std::ios::binary | std::ios::trunc);
+
+        const auto chunks  = _split(text, direction, options.chunk_size);
+        const auto threads = options.threads != 0 ? options.threads : std::max(std::thread::hardware_concurrency(), 1u);
+        const auto workers = std::min<std::size_t>(threads, std::size(chunks));
+        const auto window  = options.window != 0 ? options.window : 2 * std::max<std::size_t>(workers, 1);
+
+        // results wait in a ring of slots until the writer gets to them,
+        // chunk i can only be taken once chunk i - window has been written
+        std::vector<_chunk_result> slots(window);
+        std::mutex                 mtx;
+        std::condition_variable    cv;
+        std::size_t                next    = 0;
+        std::size_t                written = 0;
+        bool                       failed  = false;
+        std::exception_ptr         error;
+
+        auto work = [&] {
+            for (;;)
+            {
+                std::size_t i;
+                {
+                    std::unique_lock lock{ mtx };
+                    cv.wait(lock, [&] { return failed || next >= std::size(chunks) || next < written + window; });
+                    if (failed || next >= std::size(chunks))
+                        return;
+                    i = next++;
+                }
+
+                _chunk_result result;
+                try
+                {
+                    result = (direction == ConvertDirection::text_to_binary)
+                        ? _text_to_binary(text, chunks[i])
+                        : _binary_to_text(text, chunks[i]);
+                    result.ready = true;
+                }
+                catch (...)
+                {
+                    const std::scoped_lock lock{ mtx };
+                    error  = std::current_exception();
+                    failed = true;
+                    cv.notify_all();
+                    return;
+                }
+
+                {
+                    const std::scoped_lock lock{ mtx };
+                    slots[i % window] = std::move(result);
+                }
+                cv.notify_all();
+            }
+        };
+
+        // declared last, so that workers are joined before the state they share is destroyed
+        std::vector<std::jthread> pool;
+        for (std::size_t w = 0; w < workers; ++w)
+            pool.emplace_back(work);
+
+        ConvertResult result;
+        try
+        {
+            std::size_t line_base = 0;
+            for (std::size_t i = 0; i < std::size(chunks); ++i)
+            {
+                _chunk_result chunk;
+                {
+                    std::unique_lock lock{ mtx };
+                    cv.wait(lock, [&] { return failed || slots[i % window].ready; });
+                    if (failed)
+                        std::rethrow_exception(error);
+                    chunk = std::move(slots[i % window]);
+                    slots[i % window].ready = false;
+                    ++written;
+                }
+                cv.notify_all();
+
+                os.write(std::data(chunk.output), static_cast<std::streamsize>(std::size(chunk.output)));
+                for (const auto& e : chunk.errors)
+                    result.errors.push_back({ line_base + e.line + 1, e.offset });
+                line_base += chunk.lines;
+                result.converted += chunk.converted;
+            }
+            os.close();
+        }
+        catch (...)
+        {
+            {
+                const std::scoped_lock lock{ mtx };
+                failed = true;
+            }
+            cv.notify_all();
+            throw;
+        }
+        return result;
+    }
+
+} // namespace uuid
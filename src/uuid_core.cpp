@@ -1,4 +1,5 @@
 #include "uuid-cpp/uuid_core.hpp"
+#include "uuid-cpp/uuid_format.hpp"
 
 #include <atomic>
 #include <cassert>
@@ -268,8 +269,8 @@ namespace uuid
         std::array<std::byte, sizeof(_uuid_byte_layout)> bytes;
         for (size_t i = 0, j = 0; i < UUID_CANONICAL_STRING_SIZE; i += 2, ++j)
         {
-            if (s[i] == UUID_HYPEN_1_OFFSET || s[i] == UUID_HYPEN_2_OFFSET ||
-                s[i] == UUID_HYPEN_3_OFFSET || s[i] == UUID_HYPEN_4_OFFSET) // skip '-' separator
+            if (i == UUID_HYPEN_1_OFFSET || i == UUID_HYPEN_2_OFFSET ||
+                i == UUID_HYPEN_3_OFFSET || i == UUID_HYPEN_4_OFFSET) // skip '-' separator
                 ++i;
 
             const auto most_significant_bits = static_cast<unsigned char>(s[i]);
@@ -285,54 +286,9 @@ namespace uuid
 
     [[nodiscard]] std::string Uuid::string() const
     { // uuid: {8 hex-digits} '-' {4 hex-digits} '-' {4 hex-digits} '-' {4 hex-digits} '-' {12 hex-digits}
-        const char UUID_STRING_SEPARATOR = '-';
-
-        // time-low "-"
-        // time-mid "-"
-        // time-high-and-version "-"
-        // clock-seq-and-reserved clock-seq-low "-"
-        // node
-        std::string s; // { UUID_CANONICAL_STRING_SIZE, UUID_STRING_SEPARATOR };
-        s.reserve(UUID_CANONICAL_STRING_SIZE);
-
-        auto mask  = std::bit_cast<_uuid_byte_layout>(_bytes);
-        auto print = [&s](std::byte b) {
-            const auto [cl, cr] = _byte_to_ascii(b);
-            s += cl;
-            s += cr;
-        };
-
-        // time-low = 8 hex-digits ;
-        //_byte_to_ascii({ std::data(u), 4 }, { std::data(s), 8 });
-        for (auto b : mask._time_low)
-            print(b);
-        s += UUID_STRING_SEPARATOR;
-
-        // time-mid = 4 hex-digits ;
-        //_byte_to_ascii({ std::data(u) + 4, 2 }, { std::data(s) + 8 + 1, 4 });
-        for (auto b : mask._time_mid)
-            print(b);
-        s += UUID_STRING_SEPARATOR;
-
-        // time-high-and-version = 4 hex-digits ;
-        //_byte_to_ascii({ std::data(u) + 6, 2 }, { std::data(s) + 12 + 2, 4 });
-        for (auto b : mask._time_high_and_ver)
-            print(b);
-        s += UUID_STRING_SEPARATOR;
-
-        // clock-seq-and-reserved = 2 hex-digits ;
-        // clock-seq-low = 2 hex-digits ;
-        //_byte_to_ascii({ std::data(u) + 8, 2 }, { std::data(s) + 16 + 3, 4 });
-        for (auto b : mask._clock)
-            print(b);
-        s += UUID_STRING_SEPARATOR;
-
-        // node = 12 hex-digits ;
-        //_byte_to_ascii({ std::data(u) + 10, 6 }, { std::data(s) + 20 + 4, 12 });
-        for (auto b : mask._node)
-            print(b);
-
-        return s;
+        char       buffer[UUID_FORMAT_MAX_SIZE];
+        const auto n = _format_to(*this, {}, buffer);
+        return { buffer, n };
     }
 
 /*
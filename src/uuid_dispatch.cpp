@@ -0,0 +1,136 @@
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if defined(_MSC_VER) && UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(__linux__) && defined(__arm__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace uuid
+{
+    constexpr std::array<std::string_view, SIMD_LEVEL_COUNT> SIMD_LEVEL_NAMES = {
+        "scalar", "neon", "sse2", "ssse3", "avx2", "avx512"
+    };
+
+
+    std::string_view to_string(SimdLevel level) noexcept
+    {
+        return SIMD_LEVEL_NAMES[static_cast<std::size_t>(level)];
+    }
+
+    std::optional<SimdLevel> try_parse_simd_level(std::string_view name) noexcept
+    {
+        for (std::size_t i = 0; i < std::size(SIMD_LEVEL_NAMES); ++i)
+            if (SIMD_LEVEL_NAMES[i] == name)
+                return static_cast<SimdLevel>(i);
+        return std::nullopt;
+    }
+
+    [[nodiscard]] SimdLevel _detect_simd_level() noexcept
+    {
+#if UUID_CPP_SIMD_X86 && !defined(_MSC_VER)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            return SimdLevel::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::avx2;
+        if (__builtin_cpu_supports("ssse3"))
+            return SimdLevel::ssse3;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdLevel::sse2;
+        return SimdLevel::scalar;
+#elif UUID_CPP_SIMD_X86
+        int regs[4]{};
+        __cpuid(regs, 0);
+        const int max_leaf = regs[0];
+
+        __cpuid(regs, 1);
+        const bool sse2    = (regs[3] & (1 << 26)) != 0;
+        const bool ssse3   = (regs[2] & (1 << 9)) != 0;
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const bool avx     = (regs[2] & (1 << 28)) != 0;
+
+        // wide registers are usable only if the OS saves them on context switches
+        const auto xcr0        = osxsave ? _xgetbv(0) : 0;
+        const bool ymm_enabled = (xcr0 & 0x06) == 0x06;
+        const bool zmm_enabled = (xcr0 & 0xe6) == 0xe6;
+
+        bool avx2 = false, avx512 = false;
+        if (max_leaf >= 7)
+        {
+            __cpuidex(regs, 7, 0);
+            avx2   = avx && ymm_enabled && (regs[1] & (1 << 5)) != 0;
+            avx512 = avx2 && zmm_enabled && (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 30)) != 0;
+        }
+
+        if (avx512)
+            return SimdLevel::avx512;
+        if (avx2)
+            return SimdLevel::avx2;
+        if (ssse3)
+            return SimdLevel::ssse3;
+        if (sse2)
+            return SimdLevel::sse2;
+        return SimdLevel::scalar;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        return SimdLevel::neon; // mandatory on 64 bits ARM
+#elif defined(__linux__) && defined(__arm__)
+        return (::getauxval(AT_HWCAP) & HWCAP_NEON) ? SimdLevel::neon : SimdLevel::scalar;
+#else
+        return SimdLevel::scalar;
+#endif
+    }
+
+    SimdLevel detected_simd_level() noexcept
+    {
+        static const SimdLevel level = _detect_simd_level();
+        return level;
+    }
+
+    bool simd_supported(SimdLevel level) noexcept
+    {
+        const auto detected = detected_simd_level();
+        if (level == SimdLevel::scalar)
+            return true;
+        if (level == SimdLevel::neon || detected == SimdLevel::neon)
+            return level == detected;
+        return level <= detected;
+    }
+
+    void set_simd_level(SimdLevel level)
+    {
+        if (static_cast<std::size_t>(level) >= SIMD_LEVEL_COUNT || !simd_supported(level))
+            throw std::invalid_argument{ "SIMD level not supported by the processor" };
+        _simd_level.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    SimdLevel _init_simd_level() noexcept
+    {
+        auto level = detected_simd_level();
+        if (const char* name = std::getenv("UUID_CPP_SIMD"))
+        {
+            if (const auto requested = try_parse_simd_level(name))
+            {
+                // requests above the processor step down to what it can run
+                level = *requested;
+                while (!simd_supported(level))
+                    level = _simd_fallback(level);
+            }
+        }
+
+        // racing initializers all store the same value
+        auto expected = static_cast<std::uint8_t>(SIMD_LEVEL_COUNT);
+        _simd_level.compare_exchange_strong(expected, static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+        return static_cast<SimdLevel>(_simd_level.load(std::memory_order_relaxed));
+    }
+
+} // namespace uuid
@@ -0,0 +1,570 @@
+#include "uuid-cpp/uuid_encoding.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace uuid
+{
+    using _uuid_bytes = std::array<std::byte, 16>;
+
+    // sentinel value for invalid digits in decoding tables
+    constexpr const std::uint8_t _INVALID_DIGIT = 0xff;
+
+
+    [[nodiscard]] inline std::uint64_t _load_be64(const std::byte* p) noexcept
+    {
+        std::uint64_t x = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+            x = (x << 8) | std::to_integer<std::uint64_t>(p[i]);
+        return x;
+    }
+
+    inline void _store_be64(std::uint64_t x, std::byte* p) noexcept
+    {
+        for (std::size_t i = 0; i < 8; ++i)
+            p[i] = static_cast<std::byte>(x >> ((7 - i) * 8));
+    }
+
+    template <std::size_t N>
+    [[nodiscard]] constexpr std::array<std::uint8_t, 256> _make_decode_table(const char (&alphabet)[N]) noexcept
+    {
+        std::array<std::uint8_t, 256> table{};
+        table.fill(_INVALID_DIGIT);
+        for (std::size_t i = 0; i < N - 1; ++i)
+            table[static_cast<unsigned char>(alphabet[i])] = static_cast<std::uint8_t>(i);
+        return table;
+    }
+
+
+
+    // base64url ///////////////////////////////////////////////////////////
+
+    constexpr const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    static_assert(sizeof(BASE64_ALPHABET) == 64 + 1);
+
+    constexpr const auto BASE64_DECODE_TABLE = _make_decode_table(BASE64_ALPHABET);
+
+    // encodes the first 12 bytes of the source into 16 digits
+    void _base64_encode_12_scalar(const std::byte* src, char* dst) noexcept
+    {
+        for (std::size_t i = 0, j = 0; i < 12; i += 3, j += 4)
+        {
+            const std::uint32_t group = (std::to_integer<std::uint32_t>(src[i]) << 16) |
+                                        (std::to_integer<std::uint32_t>(src[i + 1]) << 8) |
+                                        std::to_integer<std::uint32_t>(src[i + 2]);
+            dst[j + 0] = BASE64_ALPHABET[(group >> 18) & 0x3f];
+            dst[j + 1] = BASE64_ALPHABET[(group >> 12) & 0x3f];
+            dst[j + 2] = BASE64_ALPHABET[(group >> 6) & 0x3f];
+            dst[j + 3] = BASE64_ALPHABET[(group >> 0) & 0x3f];
+        }
+    }
+
+    // decodes 16 digits into 12 bytes, returns false if any digit is invalid
+    [[nodiscard]] bool _base64_decode_12_scalar(const char* src, std::byte* dst) noexcept
+    {
+        // invalid digits are detected by accumulating the sentinel bits
+        std::uint32_t invalid = 0;
+        for (std::size_t i = 0, j = 0; i < 16; i += 4, j += 3)
+        {
+            std::uint32_t group = 0;
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                const auto d = static_cast<std::uint32_t>(BASE64_DECODE_TABLE[static_cast<unsigned char>(src[i + k])]);
+                invalid |= d;
+                group = (group << 6) | (d & 0x3f);
+            }
+            dst[j + 0] = static_cast<std::byte>(group >> 16);
+            dst[j + 1] = static_cast<std::byte>(group >> 8);
+            dst[j + 2] = static_cast<std::byte>(group >> 0);
+        }
+        return (invalid & 0xc0) == 0;
+    }
+
+#if UUID_CPP_SIMD_X86
+    // see W. Mula, D. Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions"
+    UUID_CPP_TARGET("ssse3") void _base64_encode_12_ssse3(const std::byte* src, char* dst) noexcept
+    {
+        // reads 16 bytes, only the first 12 are used
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        in         = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // maps each 6 bits index to the offset to be added to reach its ascii digit
+        __m128i       lut_index = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less      = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        lut_index               = _mm_or_si128(lut_index, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+        const __m128i digits = _mm_add_epi8(_mm_shuffle_epi8(offsets, lut_index), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), digits);
+    }
+
+    // 0xff in the lanes holding characters from lo to hi
+    [[nodiscard]] UUID_CPP_TARGET("ssse3") inline __m128i _in_range_ssse3(__m128i in, char lo, char hi) noexcept
+    {
+        return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(in, _mm_set1_epi8(hi + 1)));
+    }
+
+    [[nodiscard]] UUID_CPP_TARGET("ssse3") bool _base64_decode_12_ssse3(const char* src, std::byte* dst) noexcept
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+        const __m128i upper  = _in_range_ssse3(in, 'A', 'Z');
+        const __m128i lower  = _in_range_ssse3(in, 'a', 'z');
+        const __m128i digit  = _in_range_ssse3(in, '0', '9');
+        const __m128i hyphen = _mm_cmpeq_epi8(in, _mm_set1_epi8('-'));
+        const __m128i under  = _mm_cmpeq_epi8(in, _mm_set1_epi8('_'));
+
+        const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+            _mm_or_si128(digit, _mm_or_si128(hyphen, under)));
+        if (_mm_movemask_epi8(valid) != 0xffff)
+            return false;
+
+        __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+        shift         = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        shift         = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        shift         = _mm_or_si128(shift, _mm_and_si128(hyphen, _mm_set1_epi8(62 - '-')));
+        shift         = _mm_or_si128(shift, _mm_and_si128(under, _mm_set1_epi8(63 - '_')));
+        const __m128i values = _mm_add_epi8(in, shift);
+
+        const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        const __m128i out    = _mm_shuffle_epi8(packed,
+               _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        alignas(16) std::byte tmp[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(tmp), out);
+        std::copy(tmp, tmp + 12, dst);
+        return true;
+    }
+#endif
+
+    constexpr _kernel_table<void(const std::byte*, char*) noexcept> _base64_encode_12{ _base64_encode_12_scalar, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::ssse3, _base64_encode_12_ssse3 },
+#endif
+    } };
+
+    constexpr _kernel_table<bool(const char*, std::byte*) noexcept> _base64_decode_12{ _base64_decode_12_scalar, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::ssse3, _base64_decode_12_ssse3 },
+#endif
+    } };
+
+    void to_base64(const Uuid& u, std::span<char, UUID_BASE64_STRING_SIZE> out) noexcept
+    {
+        const std::byte* src = u.data();
+        char*            dst = std::data(out);
+
+        const auto at = [src](std::size_t i) { return std::to_integer<std::uint32_t>(src[i]); };
+
+        // the 16 bytes vector load is in bounds, but the store isn't
+        char head[16];
+        _base64_encode_12.get()(src, head);
+        std::copy(head, head + 16, dst);
+
+        std::size_t i = 12, j = 16;
+        for (; i + 3 <= 15; i += 3, j += 4)
+        {
+            const std::uint32_t group = (at(i) << 16) | (at(i + 1) << 8) | at(i + 2);
+            dst[j + 0] = BASE64_ALPHABET[(group >> 18) & 0x3f];
+            dst[j + 1] = BASE64_ALPHABET[(group >> 12) & 0x3f];
+            dst[j + 2] = BASE64_ALPHABET[(group >> 6) & 0x3f];
+            dst[j + 3] = BASE64_ALPHABET[(group >> 0) & 0x3f];
+        }
+        // last byte is left alone, 4 bits of zero padding
+        dst[20] = BASE64_ALPHABET[at(15) >> 2];
+        dst[21] = BASE64_ALPHABET[(at(15) & 0x03) << 4];
+    }
+
+    [[nodiscard]] std::string to_base64(const Uuid& u)
+    {
+        std::string s(UUID_BASE64_STRING_SIZE, '\0');
+        to_base64(u, std::span<char, UUID_BASE64_STRING_SIZE>{ std::data(s), UUID_BASE64_STRING_SIZE });
+        return s;
+    }
+
+    [[nodiscard]] bool _base64_decode(const char* src, _uuid_bytes& bytes) noexcept
+    {
+        const auto digit = [src](std::size_t i) {
+            return static_cast<std::uint32_t>(BASE64_DECODE_TABLE[static_cast<unsigned char>(src[i])]);
+        };
+
+        if (!_base64_decode_12.get()(src, std::data(bytes)))
+            return false;
+
+        // invalid digits are detected by accumulating the sentinel bits
+        std::size_t   i = 16, j = 12;
+        std::uint32_t invalid = 0;
+        for (; i + 4 <= 20; i += 4, j += 3)
+        {
+            const auto d0 = digit(i), d1 = digit(i + 1), d2 = digit(i + 2), d3 = digit(i + 3);
+            invalid |= d0 | d1 | d2 | d3;
+
+            const std::uint32_t group = (d0 << 18) | (d1 << 12) | (d2 << 6) | d3;
+            bytes[j + 0] = static_cast<std::byte>(group >> 16);
+            bytes[j + 1] = static_cast<std::byte>(group >> 8);
+            bytes[j + 2] = static_cast<std::byte>(group >> 0);
+        }
+        const auto d0 = digit(20), d1 = digit(21);
+        invalid |= d0 | d1;
+        bytes[15] = static_cast<std::byte>((d0 << 2) | (d1 >> 4));
+
+        // trailing padding bits must be zero for the representation to be canonical
+        return (invalid & 0xc0) == 0 && (d1 & 0x0f) == 0;
+    }
+
+    [[nodiscard]] Uuid parse_base64(const std::string_view s)
+    {
+        if (std::size(s) != UUID_BASE64_STRING_SIZE)
+            throw std::invalid_argument{ "Invalid string lenght" };
+
+        _uuid_bytes bytes;
+        if (!_base64_decode(std::data(s), bytes))
+            throw std::invalid_argument{ "Invalid base64 digit" };
+        return Uuid{ bytes };
+    }
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base64(const std::string_view s) noexcept
+    {
+        if (std::size(s) != UUID_BASE64_STRING_SIZE)
+            return {};
+
+        _uuid_bytes bytes;
+        if (!_base64_decode(std::data(s), bytes))
+            return {};
+        return Uuid{ bytes };
+    }
+
+    void to_base64_many(std::span<const Uuid> in, std::span<char> out) noexcept
+    {
+        assert(std::size(out) >= std::size(in) * UUID_BASE64_STRING_SIZE);
+        for (std::size_t i = 0; i < std::size(in); ++i)
+            to_base64(in[i], out.subspan(i * UUID_BASE64_STRING_SIZE).first<UUID_BASE64_STRING_SIZE>());
+    }
+
+    [[nodiscard]] std::size_t try_parse_base64_many(std::span<const char> in, std::span<Uuid> out) noexcept
+    {
+        const auto count = std::min(std::size(in) / UUID_BASE64_STRING_SIZE, std::size(out));
+
+        _uuid_bytes bytes;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!_base64_decode(std::data(in) + i * UUID_BASE64_STRING_SIZE, bytes))
+                return i;
+            out[i] = Uuid{ bytes };
+        }
+        return count;
+    }
+
+
+
+    // base32 //////////////////////////////////////////////////////////////
+
+    constexpr const char BASE32_ALPHABET[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+    static_assert(sizeof(BASE32_ALPHABET) == 32 + 1);
+
+    constexpr const auto BASE32_DECODE_TABLE = [] {
+        auto table = _make_decode_table(BASE32_ALPHABET);
+        // lower case letters and Crockford's aliases for commonly confused symbols
+        for (const char c : BASE32_ALPHABET)
+            if (c >= 'A' && c <= 'Z')
+                table[static_cast<unsigned char>(c - 'A' + 'a')] = table[static_cast<unsigned char>(c)];
+        table['O'] = table['o'] = 0;
+        table['I'] = table['i'] = table['L'] = table['l'] = 1;
+        return table;
+    }();
+
+    // maps 32 indices to the digits of the alphabet
+    void _base32_digits_scalar(const std::uint8_t* indices, char* digits) noexcept
+    {
+        for (std::size_t k = 0; k < 32; ++k)
+            digits[k] = BASE32_ALPHABET[indices[k]];
+    }
+
+#if UUID_CPP_SIMD_X86
+    UUID_CPP_TARGET("ssse3") void _base32_digits_ssse3(const std::uint8_t* indices, char* digits) noexcept
+    {
+        const __m128i lut_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BASE32_ALPHABET));
+        const __m128i lut_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BASE32_ALPHABET + 16));
+
+        for (std::size_t k = 0; k < 32; k += 16)
+        {
+            const __m128i idx = _mm_load_si128(reinterpret_cast<const __m128i*>(indices + k));
+            // pshufb only looks at the low 4 bits, bit 4 selects the table half
+            const __m128i high = _mm_cmpgt_epi8(idx, _mm_set1_epi8(15));
+            const __m128i a    = _mm_shuffle_epi8(lut_lo, idx);
+            const __m128i b    = _mm_shuffle_epi8(lut_hi, _mm_and_si128(idx, _mm_set1_epi8(0x0f)));
+            const __m128i c    = _mm_or_si128(_mm_andnot_si128(high, a), _mm_and_si128(high, b));
+            _mm_store_si128(reinterpret_cast<__m128i*>(digits + k), c);
+        }
+    }
+#endif
+
+    constexpr _kernel_table<void(const std::uint8_t*, char*) noexcept> _base32_digits{ _base32_digits_scalar, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::ssse3, _base32_digits_ssse3 },
+#endif
+    } };
+
+    void to_base32(const Uuid& u, std::span<char, UUID_BASE32_STRING_SIZE> out) noexcept
+    {
+        const std::uint64_t hi = _load_be64(u.data());
+        const std::uint64_t lo = _load_be64(u.data() + 8);
+
+        // 26 digits carry 130 bits, the 2 most significant ones are always zero
+        // so the first digit only encodes 3 bits of the value
+        alignas(16) std::uint8_t indices[32] = {};
+        for (std::size_t k = 0; k < UUID_BASE32_STRING_SIZE; ++k)
+        {
+            const auto shift = (UUID_BASE32_STRING_SIZE - 1 - k) * 5;
+            std::uint64_t bits;
+            if (shift >= 64)
+                bits = hi >> (shift - 64);
+            else if (shift + 5 <= 64)
+                bits = lo >> shift;
+            else
+                bits = (lo >> shift) | (hi << (64 - shift));
+            indices[k] = static_cast<std::uint8_t>(bits & 0x1f);
+        }
+
+        alignas(16) char digits[32];
+        _base32_digits.get()(indices, digits);
+        std::copy(digits, digits + UUID_BASE32_STRING_SIZE, std::data(out));
+    }
+
+    [[nodiscard]] std::string to_base32(const Uuid& u)
+    {
+        std::string s(UUID_BASE32_STRING_SIZE, '\0');
+        to_base32(u, std::span<char, UUID_BASE32_STRING_SIZE>{ std::data(s), UUID_BASE32_STRING_SIZE });
+        return s;
+    }
+
+    [[nodiscard]] bool _base32_decode(const char* src, _uuid_bytes& bytes) noexcept
+    {
+        std::uint64_t hi = 0, lo = 0;
+        std::uint32_t invalid = 0;
+        for (std::size_t k = 0; k < UUID_BASE32_STRING_SIZE; ++k)
+        {
+            const auto d = BASE32_DECODE_TABLE[static_cast<unsigned char>(src[k])];
+            invalid |= d;
+            hi = (hi << 5) | (lo >> 59);
+            lo = (lo << 5) | (d & 0x1f);
+        }
+        // first digit can't exceed the 3 bits of payload it carries
+        const auto first = BASE32_DECODE_TABLE[static_cast<unsigned char>(src[0])];
+        if ((invalid & 0xe0) != 0 || first > 0x07)
+            return false;
+
+        _store_be64(hi, std::data(bytes));
+        _store_be64(lo, std::data(bytes) + 8);
+        return true;
+    }
+
+    [[nodiscard]] Uuid parse_base32(const std::string_view s)
+    {
+        if (std::size(s) != UUID_BASE32_STRING_SIZE)
+            throw std::invalid_argument{ "Invalid string lenght" };
+
+        _uuid_bytes bytes;
+        if (!_base32_decode(std::data(s), bytes))
+            throw std::invalid_argument{ "Invalid base32 digit" };
+        return Uuid{ bytes };
+    }
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base32(const std::string_view s) noexcept
+    {
+        if (std::size(s) != UUID_BASE32_STRING_SIZE)
+            return {};
+
+        _uuid_bytes bytes;
+        if (!_base32_decode(std::data(s), bytes))
+            return {};
+        return Uuid{ bytes };
+    }
+
+    void to_base32_many(std::span<const Uuid> in, std::span<char> out) noexcept
+    {
+        assert(std::size(out) >= std::size(in) * UUID_BASE32_STRING_SIZE);
+        for (std::size_t i = 0; i < std::size(in); ++i)
+            to_base32(in[i], out.subspan(i * UUID_BASE32_STRING_SIZE).first<UUID_BASE32_STRING_SIZE>());
+    }
+
+    [[nodiscard]] std::size_t try_parse_base32_many(std::span<const char> in, std::span<Uuid> out) noexcept
+    {
+        const auto count = std::min(std::size(in) / UUID_BASE32_STRING_SIZE, std::size(out));
+
+        _uuid_bytes bytes;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!_base32_decode(std::data(in) + i * UUID_BASE32_STRING_SIZE, bytes))
+                return i;
+            out[i] = Uuid{ bytes };
+        }
+        return count;
+    }
+
+
+
+    // base58 //////////////////////////////////////////////////////////////
+
+    constexpr const char BASE58_ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    static_assert(sizeof(BASE58_ALPHABET) == 58 + 1);
+
+    constexpr const auto BASE58_DECODE_TABLE = _make_decode_table(BASE58_ALPHABET);
+
+    // largest power of 58 that fits in 32 bits, allows to work with 5 digits at a time
+    constexpr const std::uint32_t BASE58_CHUNK_DIVISOR = 58u * 58u * 58u * 58u * 58u;
+    constexpr const std::size_t   BASE58_CHUNK_DIGITS  = 5;
+
+    // 128 bit value as big endian 32 bit limbs
+    using _limbs = std::array<std::uint32_t, 4>;
+
+    void to_base58(const Uuid& u, std::span<char, UUID_BASE58_STRING_SIZE> out) noexcept
+    {
+        _limbs value;
+        for (std::size_t i = 0; i < std::size(value); ++i)
+        {
+            const std::byte* p = u.data() + i * 4;
+            value[i] = (std::to_integer<std::uint32_t>(p[0]) << 24) | (std::to_integer<std::uint32_t>(p[1]) << 16) |
+                       (std::to_integer<std::uint32_t>(p[2]) << 8) | std::to_integer<std::uint32_t>(p[3]);
+        }
+
+        // 5 chunks of 5 digits cover 25 digits, since 2^128 < 58^22
+        // the 3 most significant ones are always zero
+        char digits[25];
+        for (std::size_t chunk = 0; chunk < 5; ++chunk)
+        {
+            std::uint64_t rem = 0;
+            for (auto& limb : value)
+            {
+                const std::uint64_t cur = (rem << 32) | limb;
+                limb                    = static_cast<std::uint32_t>(cur / BASE58_CHUNK_DIVISOR);
+                rem                     = cur % BASE58_CHUNK_DIVISOR;
+            }
+
+            auto r = static_cast<std::uint32_t>(rem);
+            for (std::size_t k = 0; k < BASE58_CHUNK_DIGITS; ++k)
+            {
+                digits[std::size(digits) - 1 - chunk * BASE58_CHUNK_DIGITS - k] = BASE58_ALPHABET[r % 58];
+                r /= 58;
+            }
+        }
+        assert(digits[0] == '1' && digits[1] == '1' && digits[2] == '1');
+        std::copy(digits + 3, digits + std::size(digits), std::data(out));
+    }
+
+    [[nodiscard]] std::string to_base58(const Uuid& u)
+    {
+        std::string s(UUID_BASE58_STRING_SIZE, '\0');
+        to_base58(u, std::span<char, UUID_BASE58_STRING_SIZE>{ std::data(s), UUID_BASE58_STRING_SIZE });
+        return s;
+    }
+
+    [[nodiscard]] bool _base58_decode(const char* src, _uuid_bytes& bytes) noexcept
+    {
+        _limbs value{};
+
+        // value = value * multiplier + addend, fails on overflow of the 128 bits
+        const auto mul_add = [&value](std::uint32_t multiplier, std::uint32_t addend) {
+            std::uint64_t carry = addend;
+            for (auto it = std::rbegin(value); it != std::rend(value); ++it)
+            {
+                const std::uint64_t cur = std::uint64_t{ *it } * multiplier + carry;
+                *it                     = static_cast<std::uint32_t>(cur);
+                carry                   = cur >> 32;
+            }
+            return carry == 0;
+        };
+
+        // 22 digits = 2 leading digits + 4 chunks of 5 digits
+        std::uint32_t invalid = 0;
+        std::size_t   k       = 0;
+        for (std::size_t n : { 2, 5, 5, 5, 5 })
+        {
+            std::uint32_t multiplier = 1, addend = 0;
+            for (std::size_t end = k + n; k < end; ++k)
+            {
+                const auto d = BASE58_DECODE_TABLE[static_cast<unsigned char>(src[k])];
+                invalid |= d;
+                multiplier *= 58;
+                addend = addend * 58 + (d & 0x3f);
+            }
+            if (!mul_add(multiplier, addend))
+                return false;
+        }
+        if ((invalid & 0xc0) != 0)
+            return false;
+
+        for (std::size_t i = 0; i < std::size(value); ++i)
+        {
+            bytes[i * 4 + 0] = static_cast<std::byte>(value[i] >> 24);
+            bytes[i * 4 + 1] = static_cast<std::byte>(value[i] >> 16);
+            bytes[i * 4 + 2] = static_cast<std::byte>(value[i] >> 8);
+            bytes[i * 4 + 3] = static_cast<std::byte>(value[i] >> 0);
+        }
+        return true;
+    }
+
+    [[nodiscard]] Uuid parse_base58(const std::string_view s)
+    {
+        if (std::size(s) != UUID_BASE58_STRING_SIZE)
+            throw std::invalid_argument{ "Invalid string lenght" };
+
+        _uuid_bytes bytes;
+        if (!_base58_decode(std::data(s), bytes))
+            throw std::invalid_argument{ "Invalid base58 digit" };
+        return Uuid{ bytes };
+    }
+
+    [[nodiscard]] std::optional<Uuid> try_parse_base58(const std::string_view s) noexcept
+    {
+        if (std::size(s) != UUID_BASE58_STRING_SIZE)
+            return {};
+
+        _uuid_bytes bytes;
+        if (!_base58_decode(std::data(s), bytes))
+            return {};
+        return Uuid{ bytes };
+    }
+
+    void to_base58_many(std::span<const Uuid> in, std::span<char> out) noexcept
+    {
+        assert(std::size(out) >= std::size(in) * UUID_BASE58_STRING_SIZE);
+        for (std::size_t i = 0; i < std::size(in); ++i)
+            to_base58(in[i], out.subspan(i * UUID_BASE58_STRING_SIZE).first<UUID_BASE58_STRING_SIZE>());
+    }
+
+    [[nodiscard]] std::size_t try_parse_base58_many(std::span<const char> in, std::span<Uuid> out) noexcept
+    {
+        const auto count = std::min(std::size(in) / UUID_BASE58_STRING_SIZE, std::size(out));
+
+        _uuid_bytes bytes;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!_base58_decode(std::data(in) + i * UUID_BASE58_STRING_SIZE, bytes))
+                return i;
+            out[i] = Uuid{ bytes };
+        }
+        return count;
+    }
+
+} // namespace uuid
@@ -1,5 +1,7 @@
 #include "uuid-cpp/uuid_core.hpp"
 #include "uuid-cpp/uuid_engine.hpp"
+#include "uuid-cpp/uuid_guid.hpp"
+#include "uuid-cpp/uuid_stats.hpp"
 
 #if defined(_WIN32)
 //#include <Windows.h>
@@ -9,17 +11,31 @@
 
 #elif defined(__linux__)
 
+#include <ifaddrs.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <sys/socket.h>
 #include <uuid/uuid.h>
 
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
+#include <cstring>
 #include <ctime>
 #include <random>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace uuid
 {
@@ -42,45 +58,39 @@ namespace uuid
 
     using _node_bytes = std::array<std::byte, 6>;
 
-    [[nodiscard]] std::uint16_t _init_clock_sequence() noexcept
+    [[nodiscard]] std::uint64_t _system_entropy() noexcept
     {
-        using _rng     = std::mt19937;
-        using _adaptor = std::independent_bits_engine<_rng, sizeof(std::uint16_t), std::uint16_t>;
-
-        const auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-        //auto       rng = _rng{ seed };
-        //return _adaptor{ seed }();
-        return _adaptor{ static_cast<std::uint16_t>(seed) }();
+        try
+        {
+            std::random_device seeder;
+            return (std::uint64_t{ seeder() } << 32) | seeder();
+        }
+        catch (...)
+        {
+            // no entropy source, as in a chroot without /dev/urandom: mix values
+            // that differ across processes (pid, stack address) and calls
+            static std::atomic<std::uint64_t> calls{ 0 };
+
+            std::uint64_t state = calls.fetch_add(1, std::memory_order_relaxed);
+            state ^= static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            state ^= _fmix64(reinterpret_cast<std::uintptr_t>(&state));
+#if defined(__unix__) || defined(__APPLE__)
+            state ^= _fmix64(static_cast<std::uint64_t>(::getpid()) << 32);
+#endif
+            return _fmix64(state);
+        }
     }
 
-    [[nodiscard]] std::uint64_t _version_1_timestamp() noexcept
+    [[nodiscard]] std::uint16_t _init_clock_sequence() noexcept
     {
-        using namespace std::chrono;
-
-        // [RFC 4122 4.1.4 Timestamp]
-        // For UUID version 1, this is represented by Coordinated Universal Time(UTC)
-        // as a count of 100 - nanosecond intervals since 00 : 00 : 00.00, 15 October 1582
-        // (the date of Gregorian reform to the Christian calendar)
-
-        std::tm ref{
-            .tm_sec  = 0,
-            .tm_min  = 0,
-            .tm_hour = 0,
-            .tm_mday = 15,         // day of the month [1-31]
-            .tm_mon  = 9,          // months since January [0-11]
-            .tm_year = 1582 - 1900 // years since 1900
-        };
-        const auto old  = system_clock::from_time_t(std::mktime(&ref));
-        const auto diff = system_clock::now() - old;
-
-        const std::uint64_t timestamp = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
-        //const std::uint64_t timestamp = duration_cast<nanoseconds>(diff).count();
-        return timestamp;// / 100;
+        // drawn from the system entropy source, so that processes reseeding
+        // at the same time after a fork don't pick the same value
+        return static_cast<std::uint16_t>(_system_entropy());
     }
 
     [[nodiscard]] std::uint64_t _version_4_timestamp() noexcept
     {
-        return std::random_device{}();
+        return _system_entropy();
     }
 
     [[nodiscard]] _node_bytes _init_node_sequence()
@@ -112,47 +122,27 @@ namespace uuid
         // time_low | time_mid | time_hi_and_version
         for (std::size_t i = 0; i < 8; ++i)
             bytes[i] = static_cast<std::byte>(timestamp >> ((7 - i) * 8));
-        bytes[7] &= version_mask;
+        // the masks clear the bits above the version and variant, which are then set to one
+        bytes[6] = (bytes[6] | std::byte{ 0xf0 }) & version_mask;
 
-        // clk_seq_hi_res | clk_seq_low
+        // clk_seq_hi_res | clk_seq_low | node
         for (std::size_t i = 0; i < 8; ++i)
             bytes[i + 8] = static_cast<std::byte>(clock_and_node >> ((7 - i) * 8));
-        bytes[8] &= variant_mask;
+        bytes[8] = (bytes[8] | std::byte{ 0xc0 }) & variant_mask;
 
         return Uuid{ bytes };
     }
 
-    // build an UUID from the different parts.
-    [[nodiscard]] inline constexpr Uuid _build(
-        _version v, std::uint64_t timestamp, std::uint16_t clock, const _node_bytes& node) noexcept
-    {
-        const auto version_mask = static_cast<std::byte>(v);
-        const auto variant_mask = static_cast<std::byte>(_variant::rfc4122);
-
-        std::array<std::byte, 16> bytes{};
-        // time_low | time_mid | time_hi_and_version
-        for (std::size_t i = 0; i < 8; ++i)
-            bytes[i] = static_cast<std::byte>(timestamp >> ((7 - i) * 8));
-        bytes[7] &= version_mask;
-
-        // clk_seq_hi_res
-        bytes[8] = static_cast<std::byte>(clock >> (1 * 8));
-        bytes[8] &= variant_mask;
-        // clk_seq_low
-        bytes[9] = static_cast<std::byte>(clock >> (0 * 8));
 
-        // node
-        for (size_t i = 0; i < std::size(node); ++i)
-            bytes[10 + i] = node[i];
 
-        return Uuid{ bytes };
+    [[nodiscard]] std::uint64_t _init_random_node() noexcept
+    {
+        return _system_entropy();
     }
 
-
-
-    AddressEngine::AddressEngine()
-        : _clock{ _init_clock_sequence() }
+    [[nodiscard]] _node_bytes _init_mac_address()
     {
+        _node_bytes mac{};
 #if defined(_WIN32)
 
         ULONG size{};
@@ -166,29 +156,88 @@ namespace uuid
             throw std::runtime_error{ "Couldn't get a MAC address." };
 
         // the minimum size of a MAC address is 6 bytes so we should always be safe
-        assert(p[0].PhysicalAddressLength >= std::size(_mac));
-        for (auto i = 0; i < std::size(_mac); ++i)
-            _mac[i] = std::byte{ p[0].PhysicalAddress[i] };
+        assert(p[0].PhysicalAddressLength >= std::size(mac));
+        for (auto i = 0; i < std::size(mac); ++i)
+            mac[i] = std::byte{ p[0].PhysicalAddress[i] };
+#elif defined(__linux__)
+
+        // first interface with a hardware address, the loopback one has none
+        ::ifaddrs* list = nullptr;
+        if (::getifaddrs(&list) == 0)
+        {
+            const std::unique_ptr<::ifaddrs, void (*)(::ifaddrs*)> guard{ list, ::freeifaddrs };
+            for (const auto* p = list; p != nullptr; p = p->ifa_next)
+            {
+                if (p->ifa_addr == nullptr || p->ifa_addr->sa_family != AF_PACKET || (p->ifa_flags & IFF_LOOPBACK) != 0)
+                    continue;
+
+                const auto* link = reinterpret_cast<const ::sockaddr_ll*>(p->ifa_addr);
+                if (link->sll_halen != std::size(mac)
+                    || std::all_of(link->sll_addr, link->sll_addr + std::size(mac), [](auto b) { return b == 0; }))
+                    continue;
+                for (std::size_t i = 0; i < std::size(mac); ++i)
+                    mac[i] = std::byte{ link->sll_addr[i] };
+                return mac;
+            }
+        }
+
+        // no network interface, as in some containers: a random node with the
+        // multicast bit set, that can't collide with a real address [RFC 4122 4.5]
+        const auto node = _init_random_node();
+        for (std::size_t i = 0; i < std::size(mac); ++i)
+            mac[i] = static_cast<std::byte>(node >> ((5 - i) * 8));
+        mac[0] |= std::byte{ 0x01 };
 #else
 #error Platform not supported
 #endif
+        return mac;
     }
 
-    [[nodiscard]] Uuid AddressEngine::operator()() const noexcept
+
+
+    std::uint32_t _watch_reseed() noexcept
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        // engines compare generations on each call instead of asking for the pid,
+        // only the child is affected as the parent keeps its own state
+        [[maybe_unused]] static const int registered = ::pthread_atfork(nullptr, nullptr, [] {
+            _reseed_generation.fetch_add(1, std::memory_order_release);
+        });
+#endif
+        return _reseed_generation.load(std::memory_order_acquire);
+    }
+
+    void reseed_engines() noexcept
     {
-        return _build(_version::rfc4122_v1, _version_1_timestamp(), _clock, _mac);
+        _reseed_generation.fetch_add(1, std::memory_order_release);
     }
 
 
 
     RandomEngine::RandomEngine()
-        : _timestamp_gen{ std::random_device{}() }
-        , _clock_and_node_gen{ std::random_device{}() }
+        : _generation{ _watch_reseed() }
     {
+        _reseed();
+    }
+
+    void RandomEngine::_reseed() noexcept
+    {
+        _timestamp_gen.seed(_system_entropy());
+        _clock_and_node_gen.seed(_system_entropy());
+        _stats_count(EngineKind::random, _stats_counter::entropy_refills);
     }
 
     [[nodiscard]] Uuid RandomEngine::operator()() noexcept
     {
+        const _stats_scope scope{ EngineKind::random };
+
+        if (const auto generation = _reseed_generation.load(std::memory_order_acquire);
+            generation != _generation) [[unlikely]]
+        {
+            _reseed();
+            _generation = generation;
+        }
+
         const std::uint64_t timestamp      = _timestamp_gen();
         const std::uint64_t clock_and_node = _clock_and_node_gen();
         return _build(_version::rfc4122_v4, timestamp, clock_and_node);
@@ -196,6 +245,31 @@ namespace uuid
 
 
 
+    void parallel_generate(std::span<Uuid> out, std::uint64_t seed, std::uint64_t stream, std::size_t threads)
+    {
+        // below this size per thread, startup costs more than the work saved
+        constexpr std::size_t PARALLEL_MIN_BLOCK = 16 * 1024;
+
+        if (threads == 0)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        threads = std::clamp<std::size_t>(std::size(out) / PARALLEL_MIN_BLOCK, 1, threads);
+
+        const auto fill = [&](std::size_t first, std::size_t last) {
+            PhiloxEngine engine{ seed, stream };
+            engine.discard(first);
+            engine.generate(out.subspan(first, last - first));
+        };
+
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+        const auto block = std::size(out) / threads;
+        for (std::size_t t = 1; t < threads; ++t)
+            pool.emplace_back(fill, t * block, (t + 1 == threads) ? std::size(out) : (t + 1) * block);
+        fill(0, threads > 1 ? block : std::size(out));
+    }
+
+
+
     SystemEngine::SystemEngine()
     {
 #if defined(_WIN32)
@@ -207,38 +281,18 @@ namespace uuid
 
     [[nodiscard]] Uuid SystemEngine::operator()() const
     {
+        const _stats_scope scope{ EngineKind::system };
+
 #if defined(_WIN32)
         GUID guid;
         if (const auto err = ::CoCreateGuid(&guid); err != S_OK) [[unlikely]]
             throw std::system_error(std::error_code(err, std::system_category()));
 
+        // fields are stored in the native, little-endian, byte order
+        static_assert(sizeof(guid) == sizeof(Uuid));
         std::array<std::byte, 16> bytes{};
-
-        static_assert(sizeof(guid.Data1) == 4 * sizeof(std::byte));
-        static_assert(std::is_unsigned_v<decltype(guid.Data1)>);
-        bytes[0] = std::byte(guid.Data1 >> 24);
-        bytes[1] = std::byte(guid.Data1 >> 16);
-        bytes[2] = std::byte(guid.Data1 >> 8);
-        bytes[3] = std::byte(guid.Data1 >> 0);
-
-        static_assert(std::is_unsigned_v<decltype(guid.Data2)>);
-        bytes[4] = std::byte(guid.Data2 >> 8);
-        bytes[5] = std::byte(guid.Data2 >> 0);
-
-        static_assert(std::is_unsigned_v<decltype(guid.Data3)>);
-        bytes[6] = std::byte(guid.Data3 >> 8);
-        bytes[7] = std::byte(guid.Data3 >> 0);
-
-        bytes[8]  = std::byte{ guid.Data4[0] };
-        bytes[9]  = std::byte{ guid.Data4[1] };
-        bytes[10] = std::byte{ guid.Data4[2] };
-        bytes[11] = std::byte{ guid.Data4[3] };
-        bytes[12] = std::byte{ guid.Data4[4] };
-        bytes[13] = std::byte{ guid.Data4[5] };
-        bytes[14] = std::byte{ guid.Data4[6] };
-        bytes[15] = std::byte{ guid.Data4[7] };
-
-        return Uuid{ bytes };
+        std::memcpy(std::data(bytes), &guid, std::size(bytes));
+        return from_guid_bytes(bytes);
 
 #elif __linux__
         uuid_t native;
@@ -246,7 +300,7 @@ namespace uuid
 
         std::array<std::byte, 16> bytes{};
         static_assert(sizeof(uuid_t) == sizeof(bytes));
-        std::memcpy(std::data(bytes), native.__u_bits, std::size(bytes));
+        std::memcpy(std::data(bytes), native, std::size(bytes));
 
         return Uuid{ bytes };
 #else
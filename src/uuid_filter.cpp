@@ -0,0 +1,478 @@
+#include "uuid-cpp/uuid_filter.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace uuid
+{
+    constexpr std::uint32_t BLOOM_FILTER_MAGIC = 0x4642'5555; // "UUBF"
+    constexpr std::uint32_t XOR_FILTER_MAGIC   = 0x4658'5555; // "UUXF"
+    constexpr std::uint32_t FILTER_FORMAT      = 1;
+
+    // number of UUIDs hashed ahead of the queries in batches
+    constexpr std::size_t FILTER_BATCH_SIZE = 16;
+
+    struct _filter_header
+    {
+        std::uint32_t magic;
+        std::uint32_t format;
+        std::uint64_t length; // blocks of Bloom filters, segment lenght of xor filters
+        std::uint64_t seed;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(_filter_header) == FILTER_HEADER_SIZE);
+
+    [[nodiscard]] _filter_header _read_filter_header(std::span<const std::byte> buffer, std::uint32_t magic)
+    {
+        if (reinterpret_cast<std::uintptr_t>(std::data(buffer)) % FILTER_BUFFER_ALIGNMENT != 0)
+            throw std::invalid_argument{ "Misaligned filter buffer" };
+        if (std::size(buffer) < FILTER_HEADER_SIZE)
+            throw std::invalid_argument{ "Invalid filter lenght" };
+
+        _filter_header header;
+        std::memcpy(&header, std::data(buffer), sizeof(header));
+        if (header.magic != magic || header.format != FILTER_FORMAT)
+            throw std::invalid_argument{ "Invalid filter format" };
+        return header;
+    }
+
+    // maps a 32 bits value uniformly to [0, n) without divisions, see D. Lemire
+    // "A fast alternative to the modulo reduction"
+    [[nodiscard]] inline std::size_t _reduce(std::uint32_t x, std::size_t n) noexcept
+    {
+        return static_cast<std::size_t>((std::uint64_t{ x } * n) >> 32);
+    }
+
+
+
+    // Bloom filter ////////////////////////////////////////////////////////
+
+    constexpr std::size_t BLOOM_BLOCK_WORDS = 8;
+
+    // odd multipliers that pick one bit per word from the same hash
+    // same values as the split block Bloom filters of Apache Parquet
+    alignas(32) constexpr std::uint32_t BLOOM_SALTS[BLOOM_BLOCK_WORDS] = {
+        0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
+        0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31
+    };
+
+    // offset of the first word of the block, picked by the high half of the hash
+    [[nodiscard]] inline std::size_t _bloom_block(std::size_t block_count, std::uint64_t h) noexcept
+    {
+        return _reduce(static_cast<std::uint32_t>(h >> 32), block_count) * BLOOM_BLOCK_WORDS;
+    }
+
+    [[nodiscard]] inline std::uint32_t _bloom_bit(std::uint64_t h, std::size_t i) noexcept
+    {
+        return std::uint32_t{ 1 } << ((static_cast<std::uint32_t>(h) * BLOOM_SALTS[i]) >> 27);
+    }
+
+    BloomFilter::BloomFilter(std::span<const Uuid> keys, double bits_per_key)
+    {
+        const auto bits = static_cast<double>(std::size(keys)) * std::max(bits_per_key, 1.0);
+        _block_count    = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(bits / 256)));
+
+        auto  storage = std::make_shared<std::vector<std::uint32_t>>(_block_count * BLOOM_BLOCK_WORDS, 0);
+        auto* words   = std::data(*storage);
+        for (const auto& u : keys)
+        {
+            const auto h     = _hash64(u);
+            auto*      block = words + _bloom_block(_block_count, h);
+            for (std::size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i)
+                block[i] |= _bloom_bit(h, i);
+        }
+
+        _words = words;
+        _owner = std::move(storage);
+    }
+
+    [[nodiscard]] BloomFilter BloomFilter::view(std::span<const std::byte> buffer)
+    {
+        const auto header = _read_filter_header(buffer, BLOOM_FILTER_MAGIC);
+        if (header.length == 0 ||
+            header.length > (std::size(buffer) - FILTER_HEADER_SIZE) / (BLOOM_BLOCK_WORDS * sizeof(std::uint32_t)))
+            throw std::invalid_argument{ "Invalid filter lenght" };
+
+        BloomFilter filter;
+        filter._words       = reinterpret_cast<const std::uint32_t*>(std::data(buffer) + FILTER_HEADER_SIZE);
+        filter._block_count = static_cast<std::size_t>(header.length);
+        return filter;
+    }
+
+    [[nodiscard]] bool BloomFilter::contains(const Uuid& u) const noexcept
+    {
+        if (_block_count == 0)
+            return false;
+
+        const auto  h     = _hash64(u);
+        const auto* block = _words + _bloom_block(_block_count, h);
+        for (std::size_t i = 0; i < BLOOM_BLOCK_WORDS; ++i)
+            if ((block[i] & _bloom_bit(h, i)) == 0)
+                return false;
+        return true;
+    }
+
+    // tests the blocks of a batch of hashes
+    std::size_t _bloom_probe_scalar(
+        const std::uint64_t* hashes, const std::uint32_t* const* blocks, std::size_t n, bool* out) noexcept
+    {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            bool hit = true;
+            for (std::size_t w = 0; w < BLOOM_BLOCK_WORDS; ++w)
+                hit &= (blocks[i][w] & _bloom_bit(hashes[i], w)) != 0;
+            out[i] = hit;
+            found += hit;
+        }
+        return found;
+    }
+
+#if UUID_CPP_SIMD_X86
+    UUID_CPP_TARGET("avx2") std::size_t _bloom_probe_avx2(
+        const std::uint64_t* hashes, const std::uint32_t* const* blocks, std::size_t n, bool* out) noexcept
+    {
+        const __m256i salts = _mm256_load_si256(reinterpret_cast<const __m256i*>(BLOOM_SALTS));
+        const __m256i ones  = _mm256_set1_epi32(1);
+
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // all eight bits at once: shift 1 left by the top 5 bits of each salted hash
+            const __m256i h     = _mm256_set1_epi32(static_cast<std::int32_t>(hashes[i]));
+            const __m256i shift = _mm256_srli_epi32(_mm256_mullo_epi32(h, salts), 27);
+            const __m256i mask  = _mm256_sllv_epi32(ones, shift);
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i]));
+            const bool    hit   = _mm256_testc_si256(block, mask) != 0;
+            out[i]              = hit;
+            found += hit;
+        }
+        return found;
+    }
+#endif
+
+    constexpr _kernel_table<std::size_t(const std::uint64_t*, const std::uint32_t* const*, std::size_t, bool*) noexcept>
+        _bloom_probe{ _bloom_probe_scalar, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::avx2, _bloom_probe_avx2 },
+#endif
+        } };
+
+    std::size_t BloomFilter::contains_many(std::span<const Uuid> in, std::span<bool> out) const noexcept
+    {
+        assert(std::size(out) >= std::size(in));
+        if (_block_count == 0)
+        {
+            std::fill_n(std::begin(out), std::size(in), false);
+            return 0;
+        }
+
+        const auto  probe = _bloom_probe.get();
+        std::size_t found = 0;
+        for (std::size_t first = 0; first < std::size(in); first += FILTER_BATCH_SIZE)
+        {
+            // hash the whole batch and start loading the blocks,
+            // so that the cache misses overlap
+            const auto                                          n = std::min(FILTER_BATCH_SIZE, std::size(in) - first);
+            std::array<std::uint64_t, FILTER_BATCH_SIZE>        hashes;
+            std::array<const std::uint32_t*, FILTER_BATCH_SIZE> blocks;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                hashes[i] = _hash64(in[first + i]);
+                blocks[i] = _words + _bloom_block(_block_count, hashes[i]);
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(blocks[i]);
+#endif
+            }
+
+            found += probe(std::data(hashes), std::data(blocks), n, std::data(out) + first);
+        }
+        return found;
+    }
+
+    [[nodiscard]] std::size_t BloomFilter::serialized_size() const noexcept
+    {
+        return FILTER_HEADER_SIZE + _block_count * BLOOM_BLOCK_WORDS * sizeof(std::uint32_t);
+    }
+
+    void BloomFilter::serialize(std::span<std::byte> out) const noexcept
+    {
+        assert(std::size(out) >= serialized_size());
+
+        const _filter_header header{ BLOOM_FILTER_MAGIC, FILTER_FORMAT, _block_count, 0, 0 };
+        std::memcpy(std::data(out), &header, sizeof(header));
+        if (_block_count != 0)
+            std::memcpy(std::data(out) + FILTER_HEADER_SIZE, _words, serialized_size() - FILTER_HEADER_SIZE);
+    }
+
+
+
+    // xor filter //////////////////////////////////////////////////////////
+
+    // gives up building after this many seeds, only reachable with broken hashes
+    constexpr std::size_t XOR_FILTER_MAX_ATTEMPTS = 64;
+
+    // readable bytes before the fingerprints, the vector probe loads the 8 bytes ending at each slot;
+    // views have the header there
+    constexpr std::size_t XOR_FILTER_PADDING = 7;
+    static_assert(FILTER_HEADER_SIZE >= XOR_FILTER_PADDING);
+
+    // finalizer of MurmurHash3, rehashes the UUID hash with the seed of the filter
+    [[nodiscard]] inline std::uint64_t _xor_hash(std::uint64_t key, std::uint64_t seed) noexcept
+    {
+        std::uint64_t h = key + seed;
+        h ^= h >> 33;
+        h *= 0xff51'afd7'ed55'8ccd;
+        h ^= h >> 33;
+        h *= 0xc4ce'b9fe'1a85'ec53;
+        h ^= h >> 33;
+        return h;
+    }
+
+    [[nodiscard]] inline std::size_t _xor_index(std::uint64_t h, std::size_t j, std::size_t block_length) noexcept
+    {
+        const auto r = static_cast<std::uint32_t>(std::rotl(h, static_cast<int>(21 * j)));
+        return _reduce(r, block_length) + j * block_length;
+    }
+
+    [[nodiscard]] inline std::uint8_t _xor_fingerprint(std::uint64_t h) noexcept
+    {
+        return static_cast<std::uint8_t>(h ^ (h >> 32));
+    }
+
+    XorFilter::XorFilter(std::span<const Uuid> keys)
+    {
+        // duplicated keys would never peel off
+        std::vector<std::uint64_t> hashes(std::size(keys));
+        std::transform(std::cbegin(keys), std::cend(keys), std::begin(hashes), _hash64);
+        std::sort(std::begin(hashes), std::end(hashes));
+        hashes.erase(std::unique(std::begin(hashes), std::end(hashes)), std::end(hashes));
+
+        const auto capacity = 32 + static_cast<std::size_t>(1.23 * static_cast<double>(std::size(hashes)));
+        _block_length       = capacity / 3;
+
+        struct _set
+        {
+            std::uint64_t mask;
+            std::uint32_t count;
+        };
+        std::vector<_set>                                  sets;
+        std::vector<std::size_t>                           queue;
+        std::vector<std::pair<std::uint64_t, std::size_t>> stack;
+        stack.reserve(std::size(hashes));
+
+        std::uint64_t seed = 0x9e37'79b9'7f4a'7c15;
+        for (std::size_t attempt = 0;; ++attempt)
+        {
+            if (attempt == XOR_FILTER_MAX_ATTEMPTS)
+                throw std::runtime_error{ "Failed to build xor filter" };
+            seed = _xor_hash(seed, attempt);
+
+            sets.assign(3 * _block_length, _set{ 0, 0 });
+            for (const auto k : hashes)
+            {
+                const auto h = _xor_hash(k, seed);
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    auto& s = sets[_xor_index(h, j, _block_length)];
+                    s.mask ^= h;
+                    ++s.count;
+                }
+            }
+
+            // peel the slots referenced by a single key, until none is left
+            queue.clear();
+            stack.clear();
+            for (std::size_t i = 0; i < std::size(sets); ++i)
+                if (sets[i].count == 1)
+                    queue.push_back(i);
+
+            while (!queue.empty())
+            {
+                const auto i = queue.back();
+                queue.pop_back();
+                if (sets[i].count != 1)
+                    continue;
+
+                const auto h = sets[i].mask;
+                stack.emplace_back(h, i);
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    auto& s = sets[_xor_index(h, j, _block_length)];
+                    s.mask ^= h;
+                    if (--s.count == 1)
+                        queue.push_back(_xor_index(h, j, _block_length));
+                }
+            }
+
+            if (std::size(stack) == std::size(hashes))
+                break;
+        }
+
+        // assign in reverse peeling order, each slot is written after
+        // all the others slots of its key are final
+        auto  storage      = std::make_shared<std::vector<std::uint8_t>>(XOR_FILTER_PADDING + 3 * _block_length, 0);
+        auto* fingerprints = std::data(*storage) + XOR_FILTER_PADDING;
+        for (auto it = std::crbegin(stack); it != std::crend(stack); ++it)
+        {
+            const auto [h, i] = *it;
+            std::uint8_t fp   = _xor_fingerprint(h);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                const auto k = _xor_index(h, j, _block_length);
+                if (k != i)
+                    fp ^= fingerprints[k];
+            }
+            fingerprints[i] = fp;
+        }
+
+        _seed         = seed;
+        _fingerprints = fingerprints;
+        _owner        = std::move(storage);
+    }
+
+    [[nodiscard]] XorFilter XorFilter::view(std::span<const std::byte> buffer)
+    {
+        const auto header = _read_filter_header(buffer, XOR_FILTER_MAGIC);
+        if (header.length == 0 || header.length > (std::size(buffer) - FILTER_HEADER_SIZE) / 3)
+            throw std::invalid_argument{ "Invalid filter lenght" };
+
+        XorFilter filter;
+        filter._fingerprints = reinterpret_cast<const std::uint8_t*>(std::data(buffer) + FILTER_HEADER_SIZE);
+        filter._seed         = header.seed;
+        filter._block_length = static_cast<std::size_t>(header.length);
+        return filter;
+    }
+
+    [[nodiscard]] bool XorFilter::contains(const Uuid& u) const noexcept
+    {
+        if (_block_length == 0)
+            return false;
+
+        const auto h = _xor_hash(_hash64(u), _seed);
+        return _xor_fingerprint(h) == (_fingerprints[_xor_index(h, 0, _block_length)] ^
+                                       _fingerprints[_xor_index(h, 1, _block_length)] ^
+                                       _fingerprints[_xor_index(h, 2, _block_length)]);
+    }
+
+    // tests a batch of rehashed UUIDs
+    std::size_t _xor_probe_scalar(
+        const std::uint8_t* fingerprints, std::size_t block_length, const std::uint64_t* hashes, std::size_t n, bool* out) noexcept
+    {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto h   = hashes[i];
+            const bool hit = _xor_fingerprint(h) == (fingerprints[_xor_index(h, 0, block_length)] ^
+                                                     fingerprints[_xor_index(h, 1, block_length)] ^
+                                                     fingerprints[_xor_index(h, 2, block_length)]);
+            out[i]         = hit;
+            found += hit;
+        }
+        return found;
+    }
+
+#if UUID_CPP_SIMD_X86
+    // block lenghts must fit in 32 bits
+    UUID_CPP_TARGET("avx2") std::size_t _xor_probe_avx2(
+        const std::uint8_t* fingerprints, std::size_t block_length, const std::uint64_t* hashes, std::size_t n, bool* out) noexcept
+    {
+        // the 8 bytes ending at a slot, its fingerprint lands in the top byte
+        const auto*   base   = reinterpret_cast<const long long*>(fingerprints - XOR_FILTER_PADDING);
+        const __m256i length = _mm256_set1_epi64x(static_cast<long long>(block_length));
+        const __m256i twice  = _mm256_add_epi64(length, length);
+
+        std::size_t found = 0;
+        std::size_t i     = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes + i));
+
+            // _xor_index() for the three slots: the low 32 bits of h rotated by 21 * j,
+            // reduced to the block lenght, and offset to block j
+            const __m256i r1 = _mm256_or_si256(_mm256_slli_epi64(h, 21), _mm256_srli_epi64(h, 43));
+            const __m256i r2 = _mm256_or_si256(_mm256_slli_epi64(h, 42), _mm256_srli_epi64(h, 22));
+            const __m256i k0 = _mm256_srli_epi64(_mm256_mul_epu32(h, length), 32);
+            const __m256i k1 = _mm256_add_epi64(_mm256_srli_epi64(_mm256_mul_epu32(r1, length), 32), length);
+            const __m256i k2 = _mm256_add_epi64(_mm256_srli_epi64(_mm256_mul_epu32(r2, length), 32), twice);
+
+            const __m256i slots = _mm256_xor_si256(_mm256_xor_si256(_mm256_i64gather_epi64(base, k0, 1),
+                                                       _mm256_i64gather_epi64(base, k1, 1)),
+                _mm256_i64gather_epi64(base, k2, 1));
+            const __m256i fp    = _mm256_slli_epi64(_mm256_xor_si256(h, _mm256_srli_epi64(h, 32)), 56);
+            const __m256i diff  = _mm256_srli_epi64(_mm256_xor_si256(slots, fp), 56);
+
+            const auto hits = static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, _mm256_setzero_si256()))));
+            for (std::size_t j = 0; j < 4; ++j)
+                out[i + j] = (hits >> j) & 1;
+            found += static_cast<std::size_t>(std::popcount(hits));
+        }
+        return found + _xor_probe_scalar(fingerprints, block_length, hashes + i, n - i, out + i);
+    }
+#endif
+
+    constexpr _kernel_table<std::size_t(
+        const std::uint8_t*, std::size_t, const std::uint64_t*, std::size_t, bool*) noexcept>
+        _xor_probe{ _xor_probe_scalar, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::avx2, _xor_probe_avx2 },
+#endif
+        } };
+
+    std::size_t XorFilter::contains_many(std::span<const Uuid> in, std::span<bool> out) const noexcept
+    {
+        assert(std::size(out) >= std::size(in));
+        if (_block_length == 0)
+        {
+            std::fill_n(std::begin(out), std::size(in), false);
+            return 0;
+        }
+
+        // the vector probe reduces with 32 bits multiplies
+        const auto  probe = _block_length <= 0xffff'ffff ? _xor_probe.get() : _xor_probe_scalar;
+        std::size_t found = 0;
+        for (std::size_t first = 0; first < std::size(in); first += FILTER_BATCH_SIZE)
+        {
+            const auto                                   n = std::min(FILTER_BATCH_SIZE, std::size(in) - first);
+            std::array<std::uint64_t, FILTER_BATCH_SIZE> hashes;
+            for (std::size_t i = 0; i < n; ++i)
+                hashes[i] = _xor_hash(_hash64(in[first + i]), _seed);
+
+            found += probe(_fingerprints, _block_length, std::data(hashes), n, std::data(out) + first);
+        }
+        return found;
+    }
+
+    [[nodiscard]] std::size_t XorFilter::serialized_size() const noexcept
+    {
+        return FILTER_HEADER_SIZE + 3 * _block_length;
+    }
+
+    void XorFilter::serialize(std::span<std::byte> out) const noexcept
+    {
+        assert(std::size(out) >= serialized_size());
+
+        const _filter_header header{ XOR_FILTER_MAGIC, FILTER_FORMAT, _block_length, _seed, 0 };
+        std::memcpy(std::data(out), &header, sizeof(header));
+        if (_block_length != 0)
+            std::memcpy(std::data(out) + FILTER_HEADER_SIZE, _fingerprints, 3 * _block_length);
+    }
+
+} // namespace uuid
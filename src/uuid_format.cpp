@@ -0,0 +1,94 @@
+#include "uuid-cpp/uuid_format.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace uuid
+{
+    constexpr const char HEX_DIGITS_LOWER[] = "0123456789abcdef";
+    constexpr const char HEX_DIGITS_UPPER[] = "0123456789ABCDEF";
+
+    // writes the 32 hexadecimal digits of an UUID
+    void _to_hex_scalar(const Uuid& u, bool upper, char* out) noexcept
+    {
+        const char* digits = upper ? HEX_DIGITS_UPPER : HEX_DIGITS_LOWER;
+        for (std::size_t i = 0; i < sizeof(Uuid); ++i)
+        {
+            const auto b   = std::to_integer<std::uint8_t>(u.data()[i]);
+            out[2 * i]     = digits[b >> 4];
+            out[2 * i + 1] = digits[b & 0x0f];
+        }
+    }
+
+#if UUID_CPP_SIMD_X86
+    UUID_CPP_TARGET("ssse3") void _to_hex_ssse3(const Uuid& u, bool upper, char* out) noexcept
+    {
+        // split bytes in nibbles, that index the table of digits
+        const char*   digits = upper ? HEX_DIGITS_UPPER : HEX_DIGITS_LOWER;
+        const __m128i table  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+        const __m128i bytes  = _mm_load_si128(reinterpret_cast<const __m128i*>(u.data()));
+        const __m128i mask   = _mm_set1_epi8(0x0f);
+        const __m128i hi     = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        const __m128i lo     = _mm_shuffle_epi8(table, _mm_and_si128(bytes, mask));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+
+    constexpr _kernel_table<void(const Uuid&, bool, char*) noexcept> _to_hex{ _to_hex_scalar, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::ssse3, _to_hex_ssse3 },
+#endif
+    } };
+
+    std::size_t _format_to(const Uuid& u, _format_spec spec, std::span<char, UUID_FORMAT_MAX_SIZE> out) noexcept
+    {
+        char* p = std::data(out);
+        if (spec.wrap == 'u')
+        {
+            std::memcpy(p, "urn:uuid:", 9);
+            p += 9;
+        }
+        else if (spec.wrap == 'b')
+            *p++ = '{';
+
+        if (spec.compact)
+        {
+            _to_hex.get()(u, spec.upper, p);
+            p += 32;
+        }
+        else
+        {
+            // time-low "-" time-mid "-" time-high-and-version "-" clock-seq "-" node
+            char hex[32];
+            _to_hex.get()(u, spec.upper, hex);
+
+            const std::size_t groups[] = { 8, 4, 4, 4, 12 };
+            const char*       digits   = hex;
+            for (std::size_t g = 0; g < std::size(groups); ++g)
+            {
+                if (g != 0)
+                    *p++ = '-';
+                std::memcpy(p, digits, groups[g]);
+                p += groups[g];
+                digits += groups[g];
+            }
+        }
+
+        if (spec.wrap == 'b')
+            *p++ = '}';
+
+        assert(p <= std::data(out) + std::size(out));
+        return static_cast<std::size_t>(p - std::data(out));
+    }
+
+} // namespace uuid
@@ -0,0 +1,59 @@
+#include "uuid-cpp/uuid_guid.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <span>
+
+namespace uuid
+{
+    // each kernel converts a prefix of the input and returns its length
+    std::size_t _swap_guid_order_none(std::span<Uuid>) noexcept { return 0; }
+
+#if UUID_CPP_SIMD_X86
+    UUID_CPP_TARGET("ssse3") std::size_t _swap_guid_order_ssse3(std::span<Uuid> uuids) noexcept
+    {
+        const __m128i order = _mm_setr_epi8(3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (std::size_t i = 0; i < std::size(uuids); ++i)
+        {
+            auto*         p = reinterpret_cast<__m128i*>(&uuids[i]);
+            const __m128i v = _mm_load_si128(p);
+            _mm_store_si128(p, _mm_shuffle_epi8(v, order));
+        }
+        return std::size(uuids);
+    }
+
+    UUID_CPP_TARGET("avx2") std::size_t _swap_guid_order_avx2(std::span<Uuid> uuids) noexcept
+    {
+        // two UUIDs per step, the shuffle works on each 128 bits lane
+        const __m256i order = _mm256_setr_epi8(
+            3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15,
+            3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15);
+        std::size_t i = 0;
+        for (; i + 2 <= std::size(uuids); i += 2)
+        {
+            auto*         p = reinterpret_cast<__m256i*>(&uuids[i]);
+            const __m256i v = _mm256_loadu_si256(p); // UUIDs are only aligned to 16 bytes
+            _mm256_storeu_si256(p, _mm256_shuffle_epi8(v, order));
+        }
+        return i;
+    }
+#endif
+
+    constexpr _kernel_table<std::size_t(std::span<Uuid>) noexcept> _swap_guid_order{ _swap_guid_order_none, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::ssse3, _swap_guid_order_ssse3 },
+        { SimdLevel::avx2, _swap_guid_order_avx2 },
+#endif
+    } };
+
+    void swap_guid_order(std::span<Uuid> uuids) noexcept
+    {
+        for (std::size_t i = _swap_guid_order.get()(uuids); i < std::size(uuids); ++i)
+            uuids[i] = Uuid{ to_guid_bytes(uuids[i]) };
+    }
+
+} // namespace uuid
@@ -0,0 +1,544 @@
+#include "uuid-cpp/uuid_index.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+
+namespace uuid
+{
+    // low bits of the version word of the nodes, the rest counts the changes
+    constexpr std::uint64_t NODE_OBSOLETE = 0b01;
+    constexpr std::uint64_t NODE_LOCKED   = 0b10;
+
+    // the root splits only when full, so each level multiplies the keys at least by 32
+    constexpr std::size_t INDEX_MAX_DEPTH = 16;
+
+    // the two halves of an UUID, ordered as the UUID itself
+    struct _index_key
+    {
+        std::uint64_t hi;
+        std::uint64_t lo;
+
+        [[nodiscard]] constexpr auto operator<=>(const _index_key&) const noexcept = default;
+    };
+
+    [[nodiscard]] inline _index_key _to_index_key(const Uuid& u) noexcept
+    {
+        return { _big_endian_half(u, 0), _big_endian_half(u, 8) };
+    }
+
+    [[nodiscard]] inline Uuid _from_index_key(_index_key k) noexcept
+    {
+        std::array<std::byte, 16> bytes;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            bytes[i]     = static_cast<std::byte>(k.hi >> (56 - 8 * i));
+            bytes[i + 8] = static_cast<std::byte>(k.lo >> (56 - 8 * i));
+        }
+        return Uuid{ bytes };
+    }
+
+
+    // fields are read while other threads write them, so every access is atomic,
+    // relaxed, and readers check the version afterwards
+    struct _index_node
+    {
+        explicit _index_node(bool is_leaf) noexcept : leaf{ is_leaf } {}
+
+        std::atomic<std::uint64_t> version{ 0 };
+        std::atomic<std::uint32_t> count{ 0 }; // keys of a leaf, separators of an inner node
+        const bool                 leaf;       // nodes are only reused as the same kind
+
+        std::array<std::atomic<std::uint64_t>, INDEX_NODE_SLOTS> hi;
+        std::array<std::atomic<std::uint64_t>, INDEX_NODE_SLOTS> lo;
+    };
+
+    struct _index_leaf : _index_node
+    {
+        _index_leaf() noexcept : _index_node{ true } {}
+    };
+
+    // child i holds the keys from separator i - 1 included to separator i excluded
+    struct _index_inner : _index_node
+    {
+        _index_inner() noexcept : _index_node{ false } {}
+
+        std::array<std::atomic<_index_node*>, INDEX_NODE_SLOTS + 1> children;
+    };
+
+    [[nodiscard]] inline std::size_t _count(const _index_node& n) noexcept
+    {
+        // a reader might see a node being rewritten, the count still has to stay in bounds
+        return std::min<std::size_t>(n.count.load(std::memory_order_relaxed), INDEX_NODE_SLOTS);
+    }
+
+    [[nodiscard]] inline _index_key _key(const _index_node& n, std::size_t i) noexcept
+    {
+        return { n.hi[i].load(std::memory_order_relaxed), n.lo[i].load(std::memory_order_relaxed) };
+    }
+
+    inline void _set_key(_index_node& n, std::size_t i, _index_key k) noexcept
+    {
+        n.hi[i].store(k.hi, std::memory_order_relaxed);
+        n.lo[i].store(k.lo, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline _index_node* _child(const _index_inner& n, std::size_t i) noexcept
+    {
+        return n.children[i].load(std::memory_order_relaxed);
+    }
+
+    // index of the first key that isn't below k (or above it if upper)
+    [[nodiscard]] std::size_t _search(const _index_node& n, std::size_t count, _index_key k, bool upper) noexcept
+    {
+        // the high words decide unless they are equal, only then the low ones are loaded
+        std::size_t first = 0;
+        while (count > 0)
+        {
+            const auto half = count / 2;
+            const auto mid  = first + half;
+            const auto hi   = n.hi[mid].load(std::memory_order_relaxed);
+
+            bool before = hi < k.hi;
+            if (hi == k.hi)
+            {
+                const auto lo = n.lo[mid].load(std::memory_order_relaxed);
+                before        = upper ? lo <= k.lo : lo < k.lo;
+            }
+            if (before)
+            {
+                first = mid + 1;
+                count -= half + 1;
+            }
+            else
+                count = half;
+        }
+        return first;
+    }
+
+
+    // starts an optimistic read, fails if a writer holds the node or it left the tree
+    [[nodiscard]] inline bool _read_lock(const _index_node& n, std::uint64_t& version) noexcept
+    {
+        version = n.version.load(std::memory_order_acquire);
+        return (version & (NODE_LOCKED | NODE_OBSOLETE)) == 0;
+    }
+
+    // true if nothing was written to the node since the version was read
+    [[nodiscard]] inline bool _validate(const _index_node& n, std::uint64_t version) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return n.version.load(std::memory_order_relaxed) == version;
+    }
+
+    // turns an optimistic read into a write lock, never waits
+    [[nodiscard]] inline bool _upgrade_lock(_index_node& n, std::uint64_t version) noexcept
+    {
+        if (!n.version.compare_exchange_strong(version, version + NODE_LOCKED, std::memory_order_acquire))
+            return false;
+        // readers that see any of the writes below must also see the lock
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    // the lock bit carries into the counter
+    inline void _write_unlock(_index_node& n) noexcept
+    {
+        n.version.fetch_add(NODE_LOCKED, std::memory_order_release);
+    }
+
+    inline void _write_unlock_obsolete(_index_node& n) noexcept
+    {
+        n.version.fetch_add(NODE_LOCKED + NODE_OBSOLETE, std::memory_order_release);
+    }
+
+    // a restart means that a writer holds a node on the way, let it finish
+    inline void _backoff() noexcept { std::this_thread::yield(); }
+
+
+    // nodes from the root down to a leaf, with the versions seen on the way
+    struct _index_path
+    {
+        std::array<_index_node*, INDEX_MAX_DEPTH>  nodes;
+        std::array<std::uint64_t, INDEX_MAX_DEPTH> versions;
+        std::size_t                                depth = 0; // of the leaf
+        std::optional<_index_key>                  fence;     // first key after the leaf, if any
+    };
+
+    // goes down to the leaf that owns the key without writing anything,
+    // fails if a concurrent change forces a restart
+    [[nodiscard]] bool _descend(const std::atomic<_index_node*>& root, _index_key key, _index_path& path) noexcept
+    {
+        path.depth = 0;
+        path.fence.reset();
+
+        auto* node = root.load(std::memory_order_acquire);
+        if (!_read_lock(*node, path.versions[0]) || node != root.load(std::memory_order_acquire))
+            return false;
+        path.nodes[0] = node;
+
+        while (!node->leaf)
+        {
+            if (path.depth + 1 == INDEX_MAX_DEPTH) [[unlikely]]
+                return false;
+
+            const auto& inner   = static_cast<const _index_inner&>(*node);
+            const auto  version = path.versions[path.depth];
+            const auto  count   = _count(inner);
+            const auto  slot    = _search(inner, count, key, true);
+            if (slot < count)
+                path.fence = _key(inner, slot);
+
+            // the pointer is followed only if the node wasn't rewritten meanwhile, and the
+            // child counts only if the node still pointed to it after its version was read
+            auto* child = _child(inner, slot);
+            if (!_validate(inner, version))
+                return false;
+            auto& child_version = path.versions[path.depth + 1];
+            if (!_read_lock(*child, child_version) || !_validate(inner, version))
+                return false;
+
+            path.nodes[++path.depth] = child;
+            node                     = child;
+        }
+        return true;
+    }
+
+    // adds a separator and the child on its right, the node must be locked and not full
+    void _insert_child(_index_inner& n, _index_key separator, _index_node* child) noexcept
+    {
+        const auto count = _count(n);
+        assert(count < INDEX_NODE_SLOTS);
+
+        const auto slot = _search(n, count, separator, true);
+        for (auto i = count; i > slot; --i)
+        {
+            _set_key(n, i, _key(n, i - 1));
+            n.children[i + 1].store(_child(n, i), std::memory_order_relaxed);
+        }
+        _set_key(n, slot, separator);
+        n.children[slot + 1].store(child, std::memory_order_relaxed);
+        n.count.store(static_cast<std::uint32_t>(count + 1), std::memory_order_relaxed);
+    }
+
+
+    // the node lists are declared after the root, so it is allocated in the body
+    UuidIndex::UuidIndex() { _root.store(_new_leaf(), std::memory_order_relaxed); }
+
+    UuidIndex::~UuidIndex() = default;
+
+    _index_leaf* UuidIndex::_new_leaf()
+    {
+        std::lock_guard lock{ _nodes_mutex };
+        if (_free_leaves.empty())
+            return _leaves.emplace_back(std::make_unique<_index_leaf>()).get();
+
+        auto* leaf = _free_leaves.back();
+        _free_leaves.pop_back();
+        leaf->count.store(0, std::memory_order_relaxed);
+        // readers left behind must see a version they never saw before
+        leaf->version.store((leaf->version.load(std::memory_order_relaxed) | 0b11) + 1, std::memory_order_relaxed);
+        return leaf;
+    }
+
+    _index_inner* UuidIndex::_new_inner()
+    {
+        std::lock_guard lock{ _nodes_mutex };
+        if (_free_inners.empty())
+            return _inners.emplace_back(std::make_unique<_index_inner>()).get();
+
+        auto* inner = _free_inners.back();
+        _free_inners.pop_back();
+        inner->count.store(0, std::memory_order_relaxed);
+        inner->version.store((inner->version.load(std::memory_order_relaxed) | 0b11) + 1, std::memory_order_relaxed);
+        return inner;
+    }
+
+    void UuidIndex::_recycle(_index_node* node)
+    {
+        std::lock_guard lock{ _nodes_mutex };
+        if (node->leaf)
+            _free_leaves.push_back(static_cast<_index_leaf*>(node));
+        else
+            _free_inners.push_back(static_cast<_index_inner*>(node));
+    }
+
+    bool UuidIndex::_split(const _index_path& path, std::size_t level, const Uuid& u)
+    {
+        auto& node   = *path.nodes[level];
+        auto* parent = (level > 0) ? static_cast<_index_inner*>(path.nodes[level - 1]) : nullptr;
+
+        // allocations come first, nothing can throw while holding the locks
+        _index_node*  right = node.leaf ? static_cast<_index_node*>(_new_leaf()) : _new_inner();
+        _index_inner* root  = nullptr;
+        if (!parent)
+        {
+            try
+            {
+                root = _new_inner();
+            }
+            catch (...)
+            {
+                _recycle(right);
+                throw;
+            }
+        }
+
+        // a new root is put on top only while the old one is locked, so a successful
+        // upgrade also means that the node is still the root
+        const bool locked_parent = !parent || _upgrade_lock(*parent, path.versions[level - 1]);
+        const bool locked        = locked_parent && _upgrade_lock(node, path.versions[level]);
+        if (!locked || _count(node) < INDEX_NODE_SLOTS)
+        {
+            if (locked)
+                _write_unlock(node);
+            if (parent && locked_parent)
+                _write_unlock(*parent);
+            _recycle(right);
+            if (root)
+                _recycle(root);
+            return locked;
+        }
+
+        // keys appended after the last one, as time-ordered UUIDs, would leave the
+        // left nodes half full forever: most of the keys stay there instead
+        const auto key   = _to_index_key(u);
+        const auto count = _count(node);
+        const auto mid   = (_key(node, count - 1) < key) ? count - count / 8 : count / 2;
+
+        _index_key separator;
+        if (node.leaf)
+        {
+            // the right half moves to the new leaf, its first key separates them
+            for (auto i = mid; i < count; ++i)
+                _set_key(*right, i - mid, _key(node, i));
+            right->count.store(static_cast<std::uint32_t>(count - mid), std::memory_order_relaxed);
+            separator = _key(node, mid);
+        }
+        else
+        {
+            // the middle separator moves up, the children on its right go with the right half
+            auto& left  = static_cast<_index_inner&>(node);
+            auto& moved = static_cast<_index_inner&>(*right);
+            for (auto i = mid + 1; i < count; ++i)
+                _set_key(moved, i - mid - 1, _key(left, i));
+            for (auto i = mid + 1; i <= count; ++i)
+                moved.children[i - mid - 1].store(_child(left, i), std::memory_order_relaxed);
+            moved.count.store(static_cast<std::uint32_t>(count - mid - 1), std::memory_order_relaxed);
+            separator = _key(left, mid);
+        }
+        node.count.store(static_cast<std::uint32_t>(mid), std::memory_order_relaxed);
+
+        // the new node is published by the unlock of its parent
+        if (parent)
+            _insert_child(*parent, separator, right);
+        else
+        {
+            _set_key(*root, 0, separator);
+            root->children[0].store(&node, std::memory_order_relaxed);
+            root->children[1].store(right, std::memory_order_relaxed);
+            root->count.store(1, std::memory_order_relaxed);
+            _root.store(root, std::memory_order_release);
+        }
+
+        _write_unlock(node);
+        if (parent)
+            _write_unlock(*parent);
+        return true;
+    }
+
+    bool UuidIndex::insert(const Uuid& u)
+    {
+        const auto key = _to_index_key(u);
+        for (_index_path path;;)
+        {
+            if (!_descend(_root, key, path))
+            {
+                _backoff();
+                continue;
+            }
+
+            // the topmost full node on the way is split first, so that each
+            // split finds room in the parent, then the descent starts over,
+            // right away unless the split lost a race
+            std::size_t full = 0;
+            while (full <= path.depth && _count(*path.nodes[full]) < INDEX_NODE_SLOTS)
+                ++full;
+            if (full <= path.depth)
+            {
+                if (!_split(path, full, u))
+                    _backoff();
+                continue;
+            }
+
+            auto& leaf = *path.nodes[path.depth];
+            if (!_upgrade_lock(leaf, path.versions[path.depth]))
+            {
+                _backoff();
+                continue;
+            }
+
+            const auto count = _count(leaf);
+            const auto slot  = _search(leaf, count, key, false);
+            if (slot < count && _key(leaf, slot) == key)
+            {
+                _write_unlock(leaf);
+                return false;
+            }
+
+            for (auto i = count; i > slot; --i)
+                _set_key(leaf, i, _key(leaf, i - 1));
+            _set_key(leaf, slot, key);
+            leaf.count.store(static_cast<std::uint32_t>(count + 1), std::memory_order_relaxed);
+            _write_unlock(leaf);
+
+            _size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    bool UuidIndex::erase(const Uuid& u)
+    {
+        const auto key = _to_index_key(u);
+        for (_index_path path;; _backoff())
+        {
+            if (!_descend(_root, key, path))
+                continue;
+
+            auto& leaf = *path.nodes[path.depth];
+            if (!_upgrade_lock(leaf, path.versions[path.depth]))
+                continue;
+
+            const auto count = _count(leaf);
+            const auto slot  = _search(leaf, count, key, false);
+            if (slot == count || _key(leaf, slot) != key)
+            {
+                _write_unlock(leaf);
+                return false;
+            }
+
+            for (auto i = slot + 1; i < count; ++i)
+                _set_key(leaf, i - 1, _key(leaf, i));
+            leaf.count.store(static_cast<std::uint32_t>(count - 1), std::memory_order_relaxed);
+            _write_unlock(leaf);
+
+            _size.fetch_sub(1, std::memory_order_relaxed);
+            if (count == 1)
+                _unlink_empty(key);
+            return true;
+        }
+    }
+
+    void UuidIndex::_unlink_empty(_index_key key)
+    {
+        for (_index_path path;; _backoff())
+        {
+            if (!_descend(_root, key, path))
+                continue;
+
+            // refilled meanwhile, or emptied again by an erase that will unlink it
+            const auto& leaf = *path.nodes[path.depth];
+            if (_count(leaf) != 0 || !_validate(leaf, path.versions[path.depth]))
+                return;
+
+            // inner nodes without separators have the leaf as their only child and go with it,
+            // up to the first one that keeps other children; a single chain from the root stays
+            auto top = path.depth;
+            while (top > 0 && _count(*path.nodes[top - 1]) == 0)
+                --top;
+            if (top == 0)
+                return;
+
+            // locks never wait, the order doesn't matter
+            auto&       parent = static_cast<_index_inner&>(*path.nodes[top - 1]);
+            std::size_t locked = top - 1;
+            while (locked <= path.depth && _upgrade_lock(*path.nodes[locked], path.versions[locked]))
+                ++locked;
+            if (locked <= path.depth)
+            {
+                for (auto i = top - 1; i < locked; ++i)
+                    _write_unlock(*path.nodes[i]);
+                continue;
+            }
+
+            // child c goes with separator c - 1, its keys fall to the child on the left;
+            // the first child has none on the left and goes with separator 0
+            const auto count = _count(parent);
+            const auto slot  = _search(parent, count, key, true);
+            assert(_child(parent, slot) == path.nodes[top]);
+            for (auto i = (slot == 0) ? 1 : slot; i < count; ++i)
+                _set_key(parent, i - 1, _key(parent, i));
+            for (auto i = slot + 1; i <= count; ++i)
+                parent.children[i - 1].store(_child(parent, i), std::memory_order_relaxed);
+            parent.count.store(static_cast<std::uint32_t>(count - 1), std::memory_order_relaxed);
+            _write_unlock(parent);
+
+            for (auto i = top; i <= path.depth; ++i)
+            {
+                _write_unlock_obsolete(*path.nodes[i]);
+                _recycle(path.nodes[i]);
+            }
+            return;
+        }
+    }
+
+    bool UuidIndex::contains(const Uuid& u) const noexcept
+    {
+        const auto key = _to_index_key(u);
+        for (_index_path path;; _backoff())
+        {
+            if (!_descend(_root, key, path))
+                continue;
+
+            const auto& leaf  = *path.nodes[path.depth];
+            const auto  count = _count(leaf);
+            const auto  slot  = _search(leaf, count, key, false);
+            const bool  found = slot < count && _key(leaf, slot) == key;
+            if (_validate(leaf, path.versions[path.depth]))
+                return found;
+        }
+    }
+
+    bool UuidIndex::_collect(
+        Uuid& from, const Uuid& last, std::span<Uuid, INDEX_NODE_SLOTS> out, std::size_t& count) const noexcept
+    {
+        const auto first = _to_index_key(from);
+        const auto bound = _to_index_key(last);
+        for (_index_path path;; _backoff())
+        {
+            if (!_descend(_root, first, path))
+                continue;
+
+            // a range of time-ordered UUIDs covers whole leaves, only the
+            // ones at its ends need a search
+            const auto& leaf  = *path.nodes[path.depth];
+            const auto  size  = _count(leaf);
+            std::size_t begin = 0, end = size;
+            if (size > 0 && _key(leaf, 0) < first)
+                begin = _search(leaf, size, first, false);
+            if (size > 0 && bound < _key(leaf, size - 1))
+                end = std::max(begin, _search(leaf, size, bound, true));
+
+            for (auto i = begin; i < end; ++i)
+                out[i - begin] = _from_index_key(_key(leaf, i));
+            if (!_validate(leaf, path.versions[path.depth]))
+                continue;
+
+            count = end - begin;
+            if (!path.fence || bound < *path.fence)
+                return false;
+            from = _from_index_key(*path.fence);
+            return true;
+        }
+    }
+
+} // namespace uuid
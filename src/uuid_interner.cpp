@@ -0,0 +1,165 @@
+#include "uuid-cpp/uuid_interner.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace uuid
+{
+    // initial size of the table of each stripe, must be a power of two
+    constexpr std::size_t INTERNER_INITIAL_TABLE_SIZE = 16;
+
+
+    // checked before the storage is allocated
+    [[nodiscard]] std::size_t Interner::_checked_capacity(std::size_t capacity)
+    {
+        if (capacity >= INVALID_HANDLE)
+            throw std::invalid_argument{ "Interner capacity exceeds the range of handles" };
+        return capacity;
+    }
+
+    Interner::Interner(std::size_t capacity)
+        : _values{ std::make_unique_for_overwrite<Uuid[]>(_checked_capacity(capacity)) }
+        , _capacity{ capacity }
+    {
+        for (auto& s : _stripes)
+            s.table.assign(INTERNER_INITIAL_TABLE_SIZE, _slot{ 0, INVALID_HANDLE });
+    }
+
+    [[nodiscard]] inline std::uint32_t _interner_tag(std::size_t hash) noexcept
+    {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(hash) >> 32);
+    }
+
+    // linear probing, the slot index comes from the low bits of the hash
+    // while the stripe was selected by the high ones
+    // returns the slot holding the UUID, or the empty one where it belongs
+
+    [[nodiscard]] std::size_t Interner::_probe(const _stripe& s, const Uuid& u, std::size_t hash) const noexcept
+    {
+        const auto tag  = _interner_tag(hash);
+        const auto mask = std::size(s.table) - 1;
+        for (auto i = hash & mask;; i = (i + 1) & mask)
+        {
+            const auto& slot = s.table[i];
+            if (slot.handle == INVALID_HANDLE)
+                return i;
+            if (slot.tag == tag && _values[slot.handle] == u)
+                return i;
+        }
+    }
+
+    void Interner::_grow(_stripe& s)
+    {
+        std::vector<_slot> table(std::size(s.table) * 2, _slot{ 0, INVALID_HANDLE });
+
+        const auto mask = std::size(table) - 1;
+        for (const auto& slot : s.table)
+        {
+            if (slot.handle == INVALID_HANDLE)
+                continue;
+            auto i = _hash(_values[slot.handle]) & mask;
+            while (table[i].handle != INVALID_HANDLE)
+                i = (i + 1) & mask;
+            table[i] = slot;
+        }
+        s.table = std::move(table);
+    }
+
+    [[nodiscard]] Interner::handle_type Interner::_insert(_stripe& s, const Uuid& u, std::size_t hash)
+    {
+        // caller holds the lock of the stripe
+        auto i = _probe(s, u, hash);
+        if (s.table[i].handle != INVALID_HANDLE)
+            return s.table[i].handle;
+
+        // checked before claiming, a failed insert must not use up a handle
+        auto h = _next.load(std::memory_order_relaxed);
+        do
+        {
+            if (h >= _capacity)
+                throw std::length_error{ "Interner is full" };
+        } while (!_next.compare_exchange_weak(h, h + 1, std::memory_order_relaxed));
+        _values[h] = u;
+
+        // lock free readers only see stored UUIDs: the watermark moves past h once
+        // the inserts of all the lower handles, in other stripes, have stored theirs
+        while (_committed.load(std::memory_order_acquire) != h)
+            std::this_thread::yield();
+        _committed.store(h + 1, std::memory_order_release);
+
+        // keep the load factor under 1/2
+        if (2 * (s.count + 1) > std::size(s.table))
+        {
+            _grow(s);
+            i = _probe(s, u, hash);
+        }
+        s.table[i] = _slot{ _interner_tag(hash), static_cast<handle_type>(h) };
+        ++s.count;
+        return static_cast<handle_type>(h);
+    }
+
+    [[nodiscard]] Interner::handle_type Interner::intern(const Uuid& u)
+    {
+        const auto             hash = _hash(u);
+        auto&                  s    = _stripes[_stripe_of(hash)];
+        const std::scoped_lock lock{ s.mtx };
+        return _insert(s, u, hash);
+    }
+
+    void Interner::intern_many(std::span<const Uuid> in, std::span<handle_type> out)
+    {
+        assert(std::size(out) >= std::size(in));
+
+        // bucket the inputs by stripe, so that each lock is taken once
+        std::vector<std::size_t> hashes(std::size(in));
+        std::vector<std::size_t> offsets(STRIPE_COUNT + 1, 0);
+        for (std::size_t i = 0; i < std::size(in); ++i)
+        {
+            hashes[i] = _hash(in[i]);
+            ++offsets[_stripe_of(hashes[i]) + 1];
+        }
+        for (std::size_t k = 0; k < STRIPE_COUNT; ++k)
+            offsets[k + 1] += offsets[k];
+
+        std::vector<std::size_t> order(std::size(in));
+        {
+            auto next = offsets;
+            for (std::size_t i = 0; i < std::size(in); ++i)
+                order[next[_stripe_of(hashes[i])]++] = i;
+        }
+
+        for (std::size_t k = 0; k < STRIPE_COUNT; ++k)
+        {
+            if (offsets[k] == offsets[k + 1])
+                continue;
+
+            auto&                  s = _stripes[k];
+            const std::scoped_lock lock{ s.mtx };
+            for (auto j = offsets[k]; j < offsets[k + 1]; ++j)
+            {
+                const auto i = order[j];
+                out[i]       = _insert(s, in[i], hashes[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] std::optional<Interner::handle_type> Interner::find(const Uuid& u) const
+    {
+        const auto             hash = _hash(u);
+        const auto&            s    = _stripes[_stripe_of(hash)];
+        const std::scoped_lock lock{ s.mtx };
+        if (const auto& slot = s.table[_probe(s, u, hash)]; slot.handle != INVALID_HANDLE)
+            return slot.handle;
+        return std::nullopt;
+    }
+
+} // namespace uuid
@@ -0,0 +1,276 @@
+#include "uuid-cpp/uuid_scan.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#endif
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+namespace uuid
+{
+    // lenght of a UUID in canonical ASCII string form (hypens included)
+    constexpr std::size_t SCAN_MATCH_SIZE = 36;
+
+    // offsets of the hypens in canonical form, and of the digit groups between them
+    constexpr std::size_t SCAN_HYPEN_OFFSETS[] = { 8, 13, 18, 23 };
+    constexpr std::size_t SCAN_GROUP_OFFSETS[] = { 0, 9, 14, 19, 24 };
+    constexpr std::size_t SCAN_GROUP_SIZES[]   = { 8, 4, 4, 4, 12 };
+
+    // number of candidate positions tested by each vector step
+    constexpr std::size_t SCAN_STRIDE = 32;
+
+    // value of hexadecimal digits, 0xff for other characters
+    constexpr auto SCAN_HEX_TABLE = [] {
+        std::array<std::uint8_t, 256> table{};
+        table.fill(0xff);
+        for (std::uint8_t c = 0; c < 10; ++c)
+            table['0' + c] = c;
+        for (std::uint8_t c = 0; c < 6; ++c)
+        {
+            table['a' + c] = 10 + c;
+            table['A' + c] = 10 + c;
+        }
+        return table;
+    }();
+
+    [[nodiscard]] inline bool _is_hex(char c) noexcept
+    {
+        return SCAN_HEX_TABLE[static_cast<unsigned char>(c)] != 0xff;
+    }
+
+    // validates and decodes the candidate starting at the given offset,
+    // hypens have already been checked
+    [[nodiscard]] inline bool _scan_match(std::string_view text, std::size_t pos, Uuid& out) noexcept
+    {
+        if (pos > 0 && _is_hex(text[pos - 1]))
+            return false;
+        if (pos + SCAN_MATCH_SIZE < std::size(text) && _is_hex(text[pos + SCAN_MATCH_SIZE]))
+            return false;
+
+        std::array<std::byte, 16> bytes;
+        std::size_t               b = 0;
+        for (std::size_t g = 0; g < std::size(SCAN_GROUP_OFFSETS); ++g)
+        {
+            const char* p = std::data(text) + pos + SCAN_GROUP_OFFSETS[g];
+            for (std::size_t i = 0; i < SCAN_GROUP_SIZES[g]; i += 2)
+            {
+                const auto hi = SCAN_HEX_TABLE[static_cast<unsigned char>(p[i])];
+                const auto lo = SCAN_HEX_TABLE[static_cast<unsigned char>(p[i + 1])];
+                if ((hi | lo) == 0xff)
+                    return false;
+                bytes[b++] = static_cast<std::byte>((hi << 4) | lo);
+            }
+        }
+        out = Uuid{ bytes };
+        return true;
+    }
+
+#if UUID_CPP_SIMD_X86
+    // bit i is set if the candidate at p + i has all four hypens
+    // reads p[8] to p[SCAN_STRIDE + 23 - 1]
+    [[nodiscard]] UUID_CPP_TARGET("sse2") std::uint32_t _hypen_mask_sse2(const char* p) noexcept
+    {
+        const __m128i dash = _mm_set1_epi8('-');
+        __m128i       lo   = _mm_set1_epi8(-1);
+        __m128i       hi   = _mm_set1_epi8(-1);
+        for (const auto off : SCAN_HYPEN_OFFSETS)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + off));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + off + 16));
+            lo              = _mm_and_si128(lo, _mm_cmpeq_epi8(a, dash));
+            hi              = _mm_and_si128(hi, _mm_cmpeq_epi8(b, dash));
+        }
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(lo)) |
+               (static_cast<std::uint32_t>(_mm_movemask_epi8(hi)) << 16);
+    }
+
+    [[nodiscard]] UUID_CPP_TARGET("avx2") std::uint32_t _hypen_mask_avx2(const char* p) noexcept
+    {
+        const __m256i dash = _mm256_set1_epi8('-');
+        __m256i       all  = _mm256_set1_epi8(-1);
+        for (const auto off : SCAN_HYPEN_OFFSETS)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + off));
+            all             = _mm256_and_si256(all, _mm256_cmpeq_epi8(v, dash));
+        }
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(all));
+    }
+#endif
+
+    // no scalar kernel, the scalar loop checks one candidate at a time
+    constexpr _kernel_table<std::uint32_t(const char*) noexcept> _hypen_mask{ nullptr, {
+#if UUID_CPP_SIMD_X86
+        { SimdLevel::sse2, _hypen_mask_sse2 },
+        { SimdLevel::avx2, _hypen_mask_avx2 },
+#endif
+    } };
+
+    std::size_t _scan(std::string_view text, _scan_callback callback, void* context)
+    {
+        const auto  n     = std::size(text);
+        const char* s     = std::data(text);
+        std::size_t count = 0;
+        std::size_t pos   = 0;
+        Uuid        u;
+
+        const auto hypen_mask = _hypen_mask.get();
+        while (pos + SCAN_MATCH_SIZE <= n)
+        {
+            // vector step, as long as the loads stay inside the text
+            if (hypen_mask != nullptr && pos + SCAN_HYPEN_OFFSETS[3] + SCAN_STRIDE <= n)
+            {
+                auto mask = hypen_mask(s + pos);
+                auto next = pos + SCAN_STRIDE;
+                while (mask != 0)
+                {
+                    const auto candidate = pos + static_cast<std::size_t>(std::countr_zero(mask));
+                    if (candidate + SCAN_MATCH_SIZE > n)
+                        break; // runs past the end, as do the later ones
+                    if (_scan_match(text, candidate, u))
+                    {
+                        callback(context, u, candidate);
+                        ++count;
+                        // matches are longer than the stride, no other candidate can follow
+                        next = candidate + SCAN_MATCH_SIZE;
+                        break;
+                    }
+                    mask &= mask - 1;
+                }
+                pos = next;
+                continue;
+            }
+            if (s[pos + 8] == '-' && s[pos + 13] == '-' && s[pos + 18] == '-' && s[pos + 23] == '-' &&
+                _scan_match(text, pos, u))
+            {
+                callback(context, u, pos);
+                ++count;
+                pos += SCAN_MATCH_SIZE;
+            }
+            else
+                ++pos;
+        }
+        return count;
+    }
+
+
+    _mapped_file::_mapped_file(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        struct _handle
+        {
+            HANDLE h;
+            ~_handle()
+            {
+                if (h != NULL && h != INVALID_HANDLE_VALUE)
+                    ::CloseHandle(h);
+            }
+        };
+
+        const _handle file{ ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL) };
+        if (file.h == INVALID_HANDLE_VALUE)
+            throw std::system_error(std::error_code(::GetLastError(), std::system_category()));
+
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file.h, &size))
+            throw std::system_error(std::error_code(::GetLastError(), std::system_category()));
+        if (size.QuadPart == 0)
+            return;
+
+        // the view keeps the mapping alive after its handle is closed
+        const _handle mapping{ ::CreateFileMappingW(file.h, NULL, PAGE_READONLY, 0, 0, NULL) };
+        if (mapping.h == NULL)
+            throw std::system_error(std::error_code(::GetLastError(), std::system_category()));
+
+        const auto* view = static_cast<const char*>(::MapViewOfFile(mapping.h, FILE_MAP_READ, 0, 0, 0));
+        if (view == nullptr)
+            throw std::system_error(std::error_code(::GetLastError(), std::system_category()));
+
+        _data = view;
+        _size = static_cast<std::size_t>(size.QuadPart);
+
+#elif defined(__unix__) || defined(__APPLE__)
+        struct _fd
+        {
+            int fd;
+            ~_fd()
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+
+        const _fd file{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (file.fd < 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+
+        struct stat st;
+        if (::fstat(file.fd, &st) != 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+        if (st.st_size == 0)
+            return;
+
+        // the mapping stays valid after the descriptor is closed
+        const auto size = static_cast<std::size_t>(st.st_size);
+        void*      view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (view == MAP_FAILED)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+        ::madvise(view, size, MADV_SEQUENTIAL);
+
+        _data = static_cast<const char*>(view);
+        _size = size;
+
+#else
+        std::ifstream is{ path, std::ios::binary };
+        if (!is)
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory));
+
+        const std::string text{ std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} };
+        _copy = std::make_unique<char[]>(std::size(text));
+        std::copy(std::cbegin(text), std::cend(text), _copy.get());
+        _data = _copy.get();
+        _size = std::size(text);
+#endif
+    }
+
+    _mapped_file::~_mapped_file()
+    {
+        if (_data == nullptr || _copy)
+            return;
+#if defined(_WIN32)
+        ::UnmapViewOfFile(_data);
+#elif defined(__unix__) || defined(__APPLE__)
+        ::munmap(const_cast<char*>(_data), _size);
+#endif
+    }
+
+    std::size_t _scan_file(const std::filesystem::path& path, _scan_callback callback, void* context)
+    {
+        const _mapped_file file{ path };
+        return _scan(file.text(), callback, context);
+    }
+
+} // namespace uuid
@@ -0,0 +1,265 @@
+#include "uuid-cpp/uuid_service.hpp"
+#include "uuid-cpp/uuid_engine.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace uuid
+{
+    // number of UUIDs generated per call to the engine wrapper
+    constexpr std::size_t SERVICE_BATCH_SIZE = 64;
+
+    [[nodiscard]] long _process_id() noexcept
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        return static_cast<long>(::getpid());
+#else
+        return 0; // no fork
+#endif
+    }
+
+    GeneratorService::GeneratorService(
+        std::function<void(std::span<Uuid>)> fill, std::size_t capacity, std::size_t low_water)
+        : _generate{ std::move(fill) }
+        , _ring{ std::make_unique<_cell[]>(std::bit_ceil(std::max(capacity, 2 * SERVICE_BATCH_SIZE))) }
+        , _mask{ std::bit_ceil(std::max(capacity, 2 * SERVICE_BATCH_SIZE)) - 1 }
+        , _low_water{ low_water != 0 ? std::min(low_water, _mask) : (_mask + 1) / 4 }
+        , _owner{ _process_id() }
+        , _owner_generation{ _watch_reseed() }
+    {
+        for (std::size_t i = 0; i <= _mask; ++i)
+            _ring[i].sequence.store(i, std::memory_order_relaxed);
+
+        _thread = std::make_unique<std::thread>([this] { _run(); });
+    }
+
+    GeneratorService::~GeneratorService()
+    {
+        if (_process_id() != _owner)
+        {
+            // the thread only exists in the parent, joining would never return
+            [[maybe_unused]] auto* handle = _thread.release();
+            return;
+        }
+
+        _stopping.store(true, std::memory_order_release);
+        _refill_requested.store(true, std::memory_order_release);
+        _refill_requested.notify_one();
+        _thread->join();
+    }
+
+    // bounded queue with per cell sequence numbers, see D. Vyukov "Bounded MPMC queue",
+    // here with a single producer (the service thread) and many consumers
+
+    bool GeneratorService::_push(const Uuid& u, std::uint32_t generation) noexcept
+    {
+        const auto pos  = _tail.load(std::memory_order_relaxed);
+        auto&      cell = _ring[pos & _mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos)
+            return false; // full, the slot still holds a value from the previous lap
+
+        cell.value      = u;
+        cell.generation = generation;
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        _tail.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] std::optional<Uuid> GeneratorService::try_pop() noexcept
+    {
+        if (_forked()) [[unlikely]]
+            return {};
+
+        auto pos = _head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto&      cell = _ring[pos & _mask];
+            const auto seq  = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0)
+            {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    const Uuid u          = cell.value;
+                    const auto generation = cell.generation;
+                    cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+
+                    if (size() <= _low_water)
+                        _request_refill();
+                    // drawn before a reseed, the same value could be handed out by a clone
+                    if (generation != _reseed_generation.load(std::memory_order_acquire)) [[unlikely]]
+                    {
+                        pos = _head.load(std::memory_order_relaxed);
+                        continue;
+                    }
+                    return u;
+                }
+            }
+            else if (diff < 0)
+            {
+                _request_refill(); // empty
+                return {};
+            }
+            else
+            {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] Uuid GeneratorService::pop()
+    {
+        for (;;)
+        {
+            // read the refill count before trying, so that a refill completed
+            // in between makes the wait return immediately
+            const auto seen = _available.load(std::memory_order_acquire);
+            if (auto u = try_pop())
+                return *u;
+            if (_forked() || _stopping.load(std::memory_order_acquire))
+                _rethrow();
+            _available.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    [[nodiscard]] GeneratorService::_pop_awaiter GeneratorService::async_pop() noexcept
+    {
+        return _pop_awaiter{ this };
+    }
+
+    [[nodiscard]] std::size_t GeneratorService::size() const noexcept
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        const auto head = _head.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] bool GeneratorService::_forked() noexcept
+    {
+        // the generation changes after each fork, only then the pid is worth asking
+        const auto generation = _reseed_generation.load(std::memory_order_relaxed);
+        if (generation == _owner_generation.load(std::memory_order_relaxed)) [[likely]]
+            return false;
+        if (_process_id() != _owner)
+            return true;
+        _owner_generation.store(generation, std::memory_order_relaxed);
+        return false;
+    }
+
+    void GeneratorService::_request_refill() noexcept
+    {
+        // only the first request after a refill has to wake up the service thread
+        if (!_refill_requested.load(std::memory_order_relaxed) &&
+            !_refill_requested.exchange(true, std::memory_order_acq_rel))
+            _refill_requested.notify_one();
+    }
+
+    [[nodiscard]] bool GeneratorService::_suspend(_pop_awaiter& awaiter, std::coroutine_handle<> h)
+    {
+        const std::scoped_lock lock{ _waiters_mtx };
+        // the ring could have been refilled after await_ready()
+        if ((awaiter._value = try_pop()))
+            return false;
+        if (_forked() || _stopping.load(std::memory_order_acquire))
+            return false; // await_resume() reports the failure
+
+        awaiter._handle = h;
+        _waiters.push_back(&awaiter);
+        _request_refill();
+        return true;
+    }
+
+    [[noreturn]] void GeneratorService::_rethrow() const
+    {
+        if (_process_id() != _owner)
+            throw std::runtime_error{ "Generator service used in a forked child" };
+        if (_error)
+            std::rethrow_exception(_error);
+        throw std::runtime_error{ "Generator service stopped" };
+    }
+
+    void GeneratorService::_fill()
+    {
+        std::array<Uuid, SERVICE_BATCH_SIZE> batch;
+        while (size() <= _mask + 1 - std::size(batch) && !_stopping.load(std::memory_order_relaxed))
+        {
+            // read before drawing, so that a reseed during the batch discards it all
+            const auto generation = _reseed_generation.load(std::memory_order_acquire);
+            _generate(batch);
+
+            // room was checked up front, but a consumer moves the head before it
+            // releases the cell: wait for the release rather than drop the UUID
+            for (const auto& u : batch)
+                while (!_push(u, generation))
+                    std::this_thread::yield();
+        }
+    }
+
+    void GeneratorService::_resume_waiters()
+    {
+        std::vector<_pop_awaiter*> ready;
+        {
+            const std::scoped_lock lock{ _waiters_mtx };
+            const bool             stopping = _stopping.load(std::memory_order_acquire);
+            auto                   it       = std::begin(_waiters);
+            for (; it != std::end(_waiters); ++it)
+            {
+                if (!((*it)->_value = try_pop()) && !stopping)
+                    break;
+                ready.push_back(*it);
+            }
+            _waiters.erase(std::begin(_waiters), it);
+        }
+
+        // resumed outside of the lock, as they might await again
+        for (auto* w : ready)
+            w->_handle.resume();
+    }
+
+    void GeneratorService::_run() noexcept
+    {
+        for (;;)
+        {
+            _refill_requested.wait(false, std::memory_order_acquire);
+            if (_stopping.load(std::memory_order_acquire))
+                break;
+            // requests made during the refill make the next wait return immediately
+            _refill_requested.store(false, std::memory_order_relaxed);
+
+            try
+            {
+                _fill();
+            }
+            catch (...)
+            {
+                _error = std::current_exception();
+                _stopping.store(true, std::memory_order_release);
+            }
+
+            _available.fetch_add(1, std::memory_order_release);
+            _available.notify_all();
+            _resume_waiters();
+
+            if (_stopping.load(std::memory_order_acquire))
+                break;
+        }
+
+        // release everyone still waiting, they will observe the stop
+        _available.fetch_add(1, std::memory_order_release);
+        _available.notify_all();
+        _resume_waiters();
+    }
+
+} // namespace uuid
@@ -0,0 +1,181 @@
+#include "uuid-cpp/uuid_shard.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace uuid
+{
+    // vector kernels handle a prefix of the input and return its length, scalar code does the rest
+    [[nodiscard]] std::size_t _shard_none(std::span<const Uuid>, std::uint32_t, std::uint32_t*) noexcept { return 0; }
+
+#if UUID_CPP_SIMD_X86
+    // 64 bits multiplication modulo 2^64 out of 32 bits products
+    [[nodiscard]] UUID_CPP_TARGET("avx2") inline __m256i _mul64_avx2(__m256i a, std::uint64_t b) noexcept
+    {
+        const __m256i b_lo  = _mm256_set1_epi64x(static_cast<std::int64_t>(b & 0xffff'ffff));
+        const __m256i b_hi  = _mm256_set1_epi64x(static_cast<std::int64_t>(b >> 32));
+        const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b_lo), _mm256_mul_epu32(a, b_hi));
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b_lo), _mm256_slli_epi64(cross, 32));
+    }
+
+    // _fmix64() of each lane
+    [[nodiscard]] UUID_CPP_TARGET("avx2") inline __m256i _fmix64_avx2(__m256i h) noexcept
+    {
+        h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+        h = _mul64_avx2(h, 0xff51'afd7'ed55'8ccd);
+        h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+        h = _mul64_avx2(h, 0xc4ce'b9fe'1a85'ec53);
+        return _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+    }
+
+    // keys of four consecutive UUIDs, see _shard_key()
+    [[nodiscard]] UUID_CPP_TARGET("avx2") inline __m256i _shard_keys_avx2(const Uuid* p) noexcept
+    {
+        // byte swap each half, so that lanes hold the big endian halves as integers
+        const __m256i bswap = _mm256_setr_epi8(
+            7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+            7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        const __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), bswap);
+        const __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2)), bswap);
+
+        // halves of UUIDs 0, 2, 1, 3
+        const __m256i hi = _mm256_unpacklo_epi64(a, b);
+        const __m256i lo = _mm256_unpackhi_epi64(a, b);
+        const __m256i h  = _fmix64_avx2(_mm256_xor_si256(hi, _fmix64_avx2(lo)));
+        return _mm256_permute4x64_epi64(h, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+
+    // low 32 bits of each 64 bits lane
+    UUID_CPP_TARGET("avx2") inline void _store_low_dwords_avx2(__m256i v, std::uint32_t* out) noexcept
+    {
+        const __m256i packed = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(packed));
+    }
+
+    UUID_CPP_TARGET("avx2") std::size_t _shard_fast_range_avx2(
+        std::span<const Uuid> in, std::uint32_t n, std::uint32_t* out) noexcept
+    {
+        const __m256i count = _mm256_set1_epi64x(n);
+
+        std::size_t i = 0;
+        for (; i + 4 <= std::size(in); i += 4)
+        {
+            const __m256i key = _shard_keys_avx2(std::data(in) + i);
+            _store_low_dwords_avx2(_mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(key, 32), count), 32), out + i);
+        }
+        return i;
+    }
+
+    // four jump hashes in parallel, lanes that are done keep their bucket
+    // while the others go on, the arithmetic is the same as _jump_hash()
+    UUID_CPP_TARGET("avx2") std::size_t _shard_jump_avx2(
+        std::span<const Uuid> in, std::uint32_t n, std::uint32_t* out) noexcept
+    {
+        constexpr std::uint64_t multiplier = 2862933555777941757ull;
+
+        // integers below 2^52 convert exactly by placing them in the mantissa of 2^52
+        const __m256i magic_bits = _mm256_set1_epi64x(0x4330'0000'0000'0000);
+        const __m256d magic      = _mm256_castsi256_pd(magic_bits);
+        const __m256i one        = _mm256_set1_epi64x(1);
+        const __m256d count      = _mm256_set1_pd(static_cast<double>(n));
+        const __m256d range      = _mm256_set1_pd(static_cast<double>(1ll << 31));
+
+        std::size_t i = 0;
+        for (; i + 4 <= std::size(in); i += 4)
+        {
+            __m256i key = _shard_keys_avx2(std::data(in) + i);
+            __m256d b   = _mm256_set1_pd(-1.0);
+            __m256d j   = _mm256_setzero_pd();
+            for (;;)
+            {
+                const __m256d active = _mm256_cmp_pd(j, count, _CMP_LT_OQ);
+                if (_mm256_movemask_pd(active) == 0)
+                    break;
+                b = _mm256_blendv_pd(b, j, active);
+
+                key = _mm256_add_epi64(_mul64_avx2(key, multiplier), one);
+
+                const __m256i top  = _mm256_add_epi64(_mm256_srli_epi64(key, 33), one);
+                const __m256d div  = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(top, magic_bits)), magic);
+                const __m256d step = _mm256_div_pd(range, div);
+                const __m256d next = _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(b, _mm256_set1_pd(1.0)), step));
+                j                  = _mm256_blendv_pd(j, next, active);
+            }
+            _store_low_dwords_avx2(_mm256_castpd_si256(_mm256_add_pd(b, magic)), out + i);
+        }
+        return i;
+    }
+#endif
+
+    constexpr _kernel_table<std::size_t(std::span<const Uuid>, std::uint32_t, std::uint32_t*) noexcept> _shard_jump{
+        _shard_none, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::avx2, _shard_jump_avx2 },
+#endif
+        } };
+
+    constexpr _kernel_table<std::size_t(std::span<const Uuid>, std::uint32_t, std::uint32_t*) noexcept> _shard_fast_range{
+        _shard_none, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::avx2, _shard_fast_range_avx2 },
+#endif
+        } };
+
+    void shard_many(
+        std::span<const Uuid> in, std::uint32_t n, std::span<std::uint32_t> shard_out, ShardMethod method) noexcept
+    {
+        assert(n > 0);
+        assert(std::size(shard_out) >= std::size(in));
+
+        const auto& kernel = (method == ShardMethod::jump) ? _shard_jump : _shard_fast_range;
+        for (std::size_t i = kernel.get()(in, n, std::data(shard_out)); i < std::size(in); ++i)
+            shard_out[i] = shard(in[i], n, method);
+    }
+
+    std::vector<std::size_t> partition(std::span<Uuid> uuids, std::uint32_t n, ShardMethod method)
+    {
+        if (n == 0)
+            throw std::invalid_argument{ "Number of shards must be positive" };
+
+        std::vector<std::uint32_t> shards(std::size(uuids));
+        shard_many(uuids, n, shards, method);
+
+        std::vector<std::size_t> offsets(std::size_t{ n } + 1);
+        for (const auto s : shards)
+            ++offsets[s + 1];
+        for (std::size_t s = 0; s < n; ++s)
+            offsets[s + 1] += offsets[s];
+
+        // American flag sort: misplaced UUIDs are swapped straight into the
+        // next free slot of their run, each swap puts one UUID in its final place
+        std::vector<std::size_t> next(std::begin(offsets), std::end(offsets) - 1);
+        for (std::size_t s = 0; s < n; ++s)
+        {
+            while (next[s] < offsets[s + 1])
+            {
+                const auto i = next[s];
+                const auto t = shards[i];
+                if (t == s)
+                {
+                    ++next[s];
+                    continue;
+                }
+                const auto k = next[t]++;
+                std::swap(uuids[i], uuids[k]);
+                std::swap(shards[i], shards[k]);
+            }
+        }
+        return offsets;
+    }
+
+} // namespace uuid
@@ -0,0 +1,105 @@
+#include "uuid-cpp/uuid_shared.hpp"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace uuid
+{
+    // "uuidseq" followed by the byte of the version, never zero
+    constexpr std::uint64_t SHARED_SEQUENCE_MAGIC = 0x7575'6964'7365'7100;
+
+
+    [[nodiscard]] std::shared_ptr<_shared_sequence_block> _map_shared_sequence(const std::string& name)
+    {
+        constexpr auto size = sizeof(_shared_sequence_block);
+#if defined(_WIN32)
+        // pagefile backed sections are zero filled on creation and live as long as a handle
+        const HANDLE mapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+            static_cast<DWORD>(size), name.c_str());
+        if (mapping == NULL)
+            throw std::system_error(std::error_code(::GetLastError(), std::system_category()));
+
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (view == nullptr)
+        {
+            const auto ec = std::error_code(::GetLastError(), std::system_category());
+            ::CloseHandle(mapping);
+            throw std::system_error(ec);
+        }
+
+        return std::shared_ptr<_shared_sequence_block>{ static_cast<_shared_sequence_block*>(view),
+            [mapping](_shared_sequence_block* p) {
+                ::UnmapViewOfFile(p);
+                ::CloseHandle(mapping);
+            } };
+#else
+        struct _fd
+        {
+            int fd;
+            ~_fd()
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+
+        const _fd file{ ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600) };
+        if (file.fd < 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+
+        // the creator may have died before sizing the segment, anyone can finish the job
+        // and new pages read as zero, which is the initial state
+        struct stat st;
+        if (::fstat(file.fd, &st) != 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+        if (static_cast<std::size_t>(st.st_size) < size && ::ftruncate(file.fd, size) != 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+
+        void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+        if (view == MAP_FAILED)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+
+        return std::shared_ptr<_shared_sequence_block>{ static_cast<_shared_sequence_block*>(view),
+            [](_shared_sequence_block* p) { ::munmap(p, size); } };
+#endif
+    }
+
+    SharedSequence::SharedSequence(const std::string& name, std::uint8_t version)
+        : _block{ _map_shared_sequence(name) }
+        , _version{ version }
+    {
+        // the first process tags the segment, the header is never changed afterwards
+        const auto header   = SHARED_SEQUENCE_MAGIC | version;
+        auto       expected = std::uint64_t{ 0 };
+        if (!_block->header.compare_exchange_strong(expected, header) && expected != header)
+            throw std::invalid_argument{ "Shared sequence of another format or UUID version" };
+    }
+
+    bool SharedSequence::remove(const std::string& name)
+    {
+#if defined(_WIN32)
+        // sections go away with their last handle
+        return false;
+#else
+        if (::shm_unlink(name.c_str()) == 0)
+            return true;
+        if (errno == ENOENT)
+            return false;
+        throw std::system_error(std::error_code(errno, std::generic_category()));
+#endif
+    }
+
+} // namespace uuid
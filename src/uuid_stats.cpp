@@ -0,0 +1,95 @@
+#include "uuid-cpp/uuid_stats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace uuid
+{
+#if UUID_CPP_ENABLE_STATS
+    // every block ever allocated, blocks are recycled but never freed
+    // so that counts of terminated threads are not lost
+    std::atomic<_stats_block*> _stats_blocks{ nullptr };
+
+    [[nodiscard]] _stats_block* _stats_acquire() noexcept
+    {
+        for (auto p = _stats_blocks.load(std::memory_order_acquire); p; p = p->next)
+        {
+            bool expected = false;
+            if (!p->in_use.load(std::memory_order_relaxed) &&
+                p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return p;
+        }
+
+        auto p = new _stats_block{};
+        p->in_use.store(true, std::memory_order_relaxed);
+        p->next = _stats_blocks.load(std::memory_order_relaxed);
+        while (!_stats_blocks.compare_exchange_weak(p->next, p, std::memory_order_release))
+            ;
+        return p;
+    }
+
+    // gives back the block of the thread when it terminates
+    class _stats_owner
+    {
+    public:
+        explicit _stats_owner() noexcept
+            : _block{ _stats_acquire() }
+        {
+        }
+
+        ~_stats_owner() noexcept { _block->in_use.store(false, std::memory_order_release); }
+
+        _stats_owner(const _stats_owner&) = delete;
+        _stats_owner& operator=(const _stats_owner&) = delete;
+
+        [[nodiscard]] _stats_block& block() const noexcept { return *_block; }
+
+    private:
+        _stats_block* _block;
+    };
+
+    [[nodiscard]] _stats_block& _stats_local() noexcept
+    {
+        thread_local const _stats_owner owner{};
+        return owner.block();
+    }
+
+    [[nodiscard]] EngineStats stats_snapshot(EngineKind kind) noexcept
+    {
+        const auto k = static_cast<std::size_t>(kind);
+
+        EngineStats stats{};
+        for (auto p = _stats_blocks.load(std::memory_order_acquire); p; p = p->next)
+        {
+            const auto count = [p, k](_stats_counter c) {
+                return p->counters[k][static_cast<std::size_t>(c)].load(std::memory_order_relaxed);
+            };
+            stats.generated += count(_stats_counter::generated);
+            stats.clock_backsteps += count(_stats_counter::clock_backsteps);
+            stats.counter_overflows += count(_stats_counter::counter_overflows);
+            stats.entropy_refills += count(_stats_counter::entropy_refills);
+
+            for (std::size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i)
+                stats.latency[i] += p->latency[k][i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+#else
+
+    [[nodiscard]] _stats_block& _stats_local() noexcept
+    {
+        // never called, hooks compile to nothing
+        static _stats_block unused{};
+        return unused;
+    }
+
+    [[nodiscard]] EngineStats stats_snapshot(EngineKind) noexcept
+    {
+        return {};
+    }
+
+#endif
+
+} // namespace uuid
@@ -0,0 +1,77 @@
+#include "uuid-cpp/uuid_time.hpp"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <time.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace uuid
+{
+    [[nodiscard]] std::uint64_t CoarseTimeSource::now() const noexcept
+    {
+#if defined(_WIN32)
+        // 100 ns intervals since 1601-01-01
+        const std::uint64_t FILETIME_TO_UNIX_EPOCH = 116'444'736'000'000'000;
+
+        FILETIME ft;
+        ::GetSystemTimeAsFileTime(&ft);
+        const auto ticks = (std::uint64_t{ ft.dwHighDateTime } << 32) | ft.dwLowDateTime;
+        return (ticks - FILETIME_TO_UNIX_EPOCH) * 100;
+
+#elif defined(__linux__)
+        ::timespec ts;
+        ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return std::uint64_t(ts.tv_sec) * 1'000'000'000 + std::uint64_t(ts.tv_nsec);
+
+#else
+        return SystemTimeSource{}.now();
+#endif
+    }
+
+
+
+    struct TickerTimeSource::_ticker : TickerTimeSource::_ticker_clock
+    {
+        explicit _ticker(std::chrono::microseconds period)
+        {
+            timestamp.store(SystemTimeSource{}.now(), std::memory_order_relaxed);
+            thread = std::jthread{ [this, period](std::stop_token stop) {
+                // a stop request is noticed within a period
+                while (!stop.stop_requested())
+                {
+                    std::this_thread::sleep_for(period);
+                    timestamp.store(SystemTimeSource{}.now(), std::memory_order_relaxed);
+                }
+            } };
+        }
+
+        std::jthread thread;
+    };
+
+    TickerTimeSource::TickerTimeSource(std::chrono::microseconds period)
+    {
+        // one ticker per period, kept alive by the sources that use it
+        static std::mutex                                                  mtx;
+        static std::map<std::chrono::microseconds, std::weak_ptr<_ticker>> tickers;
+
+        const std::scoped_lock lock{ mtx };
+        auto&                  slot = tickers[period];
+        auto                   p    = slot.lock();
+        if (!p)
+        {
+            p    = std::make_shared<_ticker>(period);
+            slot = p;
+        }
+        _clock = std::move(p);
+    }
+
+} // namespace uuid
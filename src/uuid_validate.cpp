@@ -0,0 +1,143 @@
+#include "uuid-cpp/uuid_validate.hpp"
+#include "uuid-cpp/uuid_dispatch.hpp"
+
+#if UUID_CPP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace uuid
+{
+    // number of UUIDs whose fields are packed in a single vector
+    constexpr std::size_t VALIDATE_LANES = 4;
+
+    [[nodiscard]] inline bool _is_invalid(const Uuid& u, std::uint16_t allowed_versions) noexcept
+    {
+        return u.variant() != Variant::rfc4122 || ((allowed_versions >> u.version()) & 1) == 0;
+    }
+
+#if UUID_CPP_SIMD_X86
+    // shuffle masks moving byte 6 (version) of the k-th UUID to lane k,
+    // and byte 8 (variant) to lane 8 + k, all other lanes are zeroed
+    constexpr auto _FIELD_MASKS = [] {
+        std::array<std::array<std::int8_t, 16>, VALIDATE_LANES> masks{};
+        for (std::size_t k = 0; k < VALIDATE_LANES; ++k)
+        {
+            masks[k].fill(-128);
+            masks[k][k]     = 6;
+            masks[k][8 + k] = 8;
+        }
+        return masks;
+    }();
+
+    // packs the version and variant bytes of four consecutive UUIDs
+    [[nodiscard]] UUID_CPP_TARGET("ssse3") inline __m128i _gather_fields(const Uuid* p) noexcept
+    {
+        __m128i fields = _mm_setzero_si128();
+        for (std::size_t k = 0; k < VALIDATE_LANES; ++k)
+        {
+            const __m128i u    = _mm_load_si128(reinterpret_cast<const __m128i*>(p + k));
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(std::data(_FIELD_MASKS[k])));
+            fields             = _mm_or_si128(fields, _mm_shuffle_epi8(u, mask));
+        }
+        return fields;
+    }
+
+    [[nodiscard]] UUID_CPP_TARGET("ssse3") inline __m128i _version_nibbles(__m128i fields) noexcept
+    {
+        return _mm_and_si128(_mm_srli_epi16(fields, 4), _mm_set1_epi8(0x0f));
+    }
+
+    UUID_CPP_TARGET("ssse3") std::size_t _classify_ssse3(std::span<const Uuid> in, std::uint8_t* version_out) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + VALIDATE_LANES <= std::size(in); i += VALIDATE_LANES)
+        {
+            const auto versions = _mm_cvtsi128_si32(_version_nibbles(_gather_fields(std::data(in) + i)));
+            std::memcpy(version_out + i, &versions, VALIDATE_LANES);
+        }
+        return i;
+    }
+
+    UUID_CPP_TARGET("ssse3") std::size_t _validate_ssse3(
+        std::span<const Uuid> in, std::uint16_t allowed_versions, std::uint64_t* invalid_out) noexcept
+    {
+        // 0xff in the lanes of the allowed versions, looked up with the version nibbles
+        alignas(16) std::array<std::uint8_t, 16> allowed{};
+        for (std::size_t v = 0; v < std::size(allowed); ++v)
+            allowed[v] = ((allowed_versions >> v) & 1) ? 0xff : 0x00;
+        const __m128i allowed_table = _mm_load_si128(reinterpret_cast<const __m128i*>(std::data(allowed)));
+
+        std::size_t i = 0;
+        for (; i + VALIDATE_LANES <= std::size(in); i += VALIDATE_LANES)
+        {
+            const __m128i fields  = _gather_fields(std::data(in) + i);
+            const __m128i version = _mm_shuffle_epi8(allowed_table, _version_nibbles(fields));
+            const __m128i variant = _mm_cmpeq_epi8(
+                _mm_and_si128(fields, _mm_set1_epi8(static_cast<char>(0xc0))), _mm_set1_epi8(static_cast<char>(0x80)));
+
+            const auto valid = static_cast<std::uint64_t>(_mm_movemask_epi8(version) & (_mm_movemask_epi8(variant) >> 8));
+            invalid_out[i / 64] |= (~valid & 0x0f) << (i % 64);
+        }
+        return i;
+    }
+#endif
+
+    // vector kernels handle a prefix of the input and return its length, scalar code does the rest
+    [[nodiscard]] std::size_t _classify_none(std::span<const Uuid>, std::uint8_t*) noexcept { return 0; }
+    [[nodiscard]] std::size_t _validate_none(std::span<const Uuid>, std::uint16_t, std::uint64_t*) noexcept { return 0; }
+
+    constexpr _kernel_table<std::size_t(std::span<const Uuid>, std::uint8_t*) noexcept> _classify_prefix{
+        _classify_none, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::ssse3, _classify_ssse3 },
+#endif
+        } };
+
+    constexpr _kernel_table<std::size_t(std::span<const Uuid>, std::uint16_t, std::uint64_t*) noexcept> _validate_prefix{
+        _validate_none, {
+#if UUID_CPP_SIMD_X86
+            { SimdLevel::ssse3, _validate_ssse3 },
+#endif
+        } };
+
+    VersionCounts classify_many(std::span<const Uuid> in, std::span<std::uint8_t> version_out) noexcept
+    {
+        assert(std::size(version_out) >= std::size(in));
+
+        std::size_t i = _classify_prefix.get()(in, std::data(version_out));
+        for (; i < std::size(in); ++i)
+            version_out[i] = in[i].version();
+
+        VersionCounts counts{};
+        for (std::size_t j = 0; j < std::size(in); ++j)
+            ++counts[version_out[j]];
+        return counts;
+    }
+
+    std::size_t validate_many(
+        std::span<const Uuid> in, std::uint16_t allowed_versions, std::span<std::uint64_t> invalid_out) noexcept
+    {
+        const auto words = (std::size(in) + 63) / 64;
+        assert(std::size(invalid_out) >= words);
+        std::fill_n(std::begin(invalid_out), words, std::uint64_t{ 0 });
+
+        std::size_t i = _validate_prefix.get()(in, allowed_versions, std::data(invalid_out));
+        for (; i < std::size(in); ++i)
+            invalid_out[i / 64] |= std::uint64_t{ _is_invalid(in[i], allowed_versions) } << (i % 64);
+
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < words; ++w)
+            count += static_cast<std::size_t>(std::popcount(invalid_out[w]));
+        return count;
+    }
+
+} // namespace uuid
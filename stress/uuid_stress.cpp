@@ -0,0 +1,629 @@
+// Uniqueness stress harness: drives engines from many threads, and optionally
+// many processes, for a fixed time, then looks for repeated UUIDs and for
+// time-ordered engines going backwards. Exits with 1 if anything was found.
+//
+//   uuid-cpp-stress [--engines=random,time,...] [--threads=N] [--processes=N]
+//                   [--seconds=S] [--collector=sort|hash] [--run-size=N]
+//                   [--dir=PATH] [--per-thread]
+
+#include "uuid-cpp/uuid.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define UUID_CPP_STRESS_FORK 1
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace uuid;
+
+// UUIDs generated between two looks at the clock
+constexpr std::size_t STRESS_BATCH_SIZE = 4096;
+
+// independently locked parts of the hash set
+constexpr std::size_t HASH_SHARDS = 64;
+
+
+struct _options
+{
+    std::vector<std::string> engines{ "random", "philox", "system", "address", "ordered-address", "time", "pooled",
+        "shared-address", "shared-ordered-address", "shared-time" };
+    std::size_t              threads    = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t              processes  = 1;
+    double                   seconds    = 1.0;
+    std::string              collector  = "sort";
+    std::size_t              run_size   = std::size_t{ 1 } << 22; // 64 MiB of UUIDs per thread
+    std::filesystem::path    dir        = std::filesystem::temp_directory_path();
+    bool                     per_thread = false; // one engine per thread, even for thread-safe ones
+};
+
+// what a thread did, sent back through a pipe by forked processes
+struct _worker_result
+{
+    std::uint64_t count;
+    std::uint64_t order_violations;
+    double        seconds;
+};
+
+
+
+// collectors //////////////////////////////////////////////////////////////
+
+// receives the UUIDs of one thread
+class _id_writer
+{
+public:
+    virtual ~_id_writer() = default;
+
+    virtual void add(std::span<const Uuid> ids) = 0;
+    virtual void close() = 0;
+};
+
+class _collector
+{
+public:
+    virtual ~_collector() = default;
+
+    [[nodiscard]] virtual std::unique_ptr<_id_writer> writer() = 0;
+
+    /// @brief Number of UUIDs equal to one seen before, once all writers are closed.
+    [[nodiscard]] virtual std::uint64_t duplicates() = 0;
+};
+
+
+// hash set split in shards, each with its own lock, detects repeats as they come
+class _hash_collector final : public _collector
+{
+public:
+    class _writer final : public _id_writer
+    {
+    public:
+        explicit _writer(_hash_collector& owner) noexcept
+            : _owner{ owner }
+        {
+        }
+
+        void add(std::span<const Uuid> ids) override
+        {
+            // one lock per shard and batch
+            for (const auto& u : ids)
+                _buckets[_hash64(u) % HASH_SHARDS].push_back(u);
+            for (std::size_t s = 0; s < HASH_SHARDS; ++s)
+            {
+                if (_buckets[s].empty())
+                    continue;
+                std::uint64_t    repeated = 0;
+                std::scoped_lock lock{ _owner._shards[s].lock };
+                for (const auto& u : _buckets[s])
+                    repeated += !_owner._shards[s].ids.insert(u).second;
+                _owner._duplicates.fetch_add(repeated, std::memory_order_relaxed);
+                _buckets[s].clear();
+            }
+        }
+
+        void close() override {}
+
+    private:
+        _hash_collector&                           _owner;
+        std::array<std::vector<Uuid>, HASH_SHARDS> _buckets;
+    };
+
+    [[nodiscard]] std::unique_ptr<_id_writer> writer() override { return std::make_unique<_writer>(*this); }
+
+    [[nodiscard]] std::uint64_t duplicates() override { return _duplicates.load(); }
+
+private:
+    struct alignas(64) _shard
+    {
+        std::mutex               lock;
+        std::unordered_set<Uuid> ids;
+    };
+
+    std::unique_ptr<_shard[]>  _shards = std::make_unique<_shard[]>(HASH_SHARDS);
+    std::atomic<std::uint64_t> _duplicates{ 0 };
+};
+
+
+// sorted runs spilled to files, merged at the end: memory stays bounded by
+// the run size, so billions of UUIDs can be checked
+class _run_collector final : public _collector
+{
+public:
+    _run_collector(std::filesystem::path dir, std::size_t run_size)
+        : _dir{ std::move(dir) }
+        , _run_size{ run_size }
+    {
+        std::filesystem::create_directories(_dir);
+    }
+
+    class _writer final : public _id_writer
+    {
+    public:
+        explicit _writer(_run_collector& owner)
+            : _owner{ owner }
+        {
+            _run.reserve(owner._run_size);
+        }
+
+        void add(std::span<const Uuid> ids) override
+        {
+            _run.insert(std::end(_run), std::begin(ids), std::end(ids));
+            if (std::size(_run) >= _owner._run_size)
+                _spill();
+        }
+
+        void close() override
+        {
+            if (!_run.empty())
+                _spill();
+        }
+
+    private:
+        void _spill()
+        {
+            std::sort(std::begin(_run), std::end(_run));
+            _owner._write_run(_run);
+            _run.clear();
+        }
+
+        _run_collector&   _owner;
+        std::vector<Uuid> _run;
+    };
+
+    [[nodiscard]] std::unique_ptr<_id_writer> writer() override { return std::make_unique<_writer>(*this); }
+
+    [[nodiscard]] std::uint64_t duplicates() override
+    {
+        struct _reader
+        {
+            std::ifstream     in;
+            std::vector<Uuid> buffer = std::vector<Uuid>(STRESS_BATCH_SIZE);
+            std::size_t       pos    = 0;
+            std::size_t       size   = 0;
+
+            bool next(Uuid& u)
+            {
+                if (pos == size)
+                {
+                    in.read(reinterpret_cast<char*>(std::data(buffer)), std::size(buffer) * sizeof(Uuid));
+                    size = static_cast<std::size_t>(in.gcount()) / sizeof(Uuid);
+                    pos  = 0;
+                    if (size == 0)
+                        return false;
+                }
+                u = buffer[pos++];
+                return true;
+            }
+        };
+
+        std::vector<std::unique_ptr<_reader>> readers;
+        for (const auto& entry : std::filesystem::directory_iterator{ _dir })
+            if (entry.path().extension() == ".run")
+                readers.push_back(std::make_unique<_reader>(_reader{ std::ifstream{ entry.path(), std::ios::binary } }));
+
+        // k-way merge, repeats come out next to each other
+        using _head     = std::pair<Uuid, std::size_t>;
+        const auto more = [](const _head& a, const _head& b) { return b.first < a.first; };
+        std::priority_queue<_head, std::vector<_head>, decltype(more)> heads{ more };
+        for (std::size_t r = 0; r < std::size(readers); ++r)
+            if (Uuid u; readers[r]->next(u))
+                heads.emplace(u, r);
+
+        std::uint64_t duplicates = 0;
+        bool          first      = true;
+        Uuid          last{};
+        while (!heads.empty())
+        {
+            const auto [u, r] = heads.top();
+            heads.pop();
+            duplicates += (!first && u == last);
+            first = false;
+            last  = u;
+            if (Uuid next; readers[r]->next(next))
+                heads.emplace(next, r);
+        }
+        return duplicates;
+    }
+
+private:
+    void _write_run(std::span<const Uuid> run)
+    {
+#if UUID_CPP_STRESS_FORK
+        const auto pid = static_cast<long>(::getpid());
+#else
+        const auto pid = 0l;
+#endif
+        const auto    name = std::to_string(pid) + "-" + std::to_string(_runs.fetch_add(1)) + ".run";
+        std::ofstream out{ _dir / name, std::ios::binary };
+        out.exceptions(std::ios::failbit | std::ios::badbit);
+        out.write(reinterpret_cast<const char*>(std::data(run)), std::size(run) * sizeof(Uuid));
+    }
+
+    std::filesystem::path    _dir;
+    std::size_t              _run_size;
+    std::atomic<std::size_t> _runs{ 0 };
+};
+
+
+
+// engines /////////////////////////////////////////////////////////////////
+
+template <typename Engine>
+[[nodiscard]] static Uuid _next(Engine& engine)
+{
+    if constexpr (requires { engine.pop(); })
+        return engine.pop();
+    else
+        return engine();
+}
+
+// generates until the deadline, checking order within the thread
+template <typename Engine>
+[[nodiscard]] static _worker_result _drive(Engine& engine, bool ordered, double seconds, _id_writer& out)
+{
+    using clock = std::chrono::steady_clock;
+    const auto start    = clock::now();
+    const auto deadline = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>{ seconds });
+
+    std::vector<Uuid> batch(STRESS_BATCH_SIZE);
+    _worker_result    result{ 0, 0, 0.0 };
+    bool              first = true;
+    Uuid              last{};
+    do
+    {
+        for (auto& u : batch)
+            u = _next(engine);
+        if (ordered)
+            for (const auto& u : batch)
+            {
+                result.order_violations += (!first && !(last < u));
+                first = false;
+                last  = u;
+            }
+        out.add(batch);
+        result.count += std::size(batch);
+    } while (clock::now() < deadline);
+
+    // the final sort or spill isn't part of the generation rate
+    result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    out.close();
+    return result;
+}
+
+// runs the threads of one process, engines are made by make(worker index)
+template <typename Engine, typename Make>
+[[nodiscard]] static std::vector<_worker_result> _run_threads(
+    const _options& options, std::size_t process, bool ordered, bool thread_safe, Make make, _collector& collector)
+{
+    const bool              shared = thread_safe && !options.per_thread;
+    std::unique_ptr<Engine> common = shared ? make(process * options.threads) : nullptr;
+
+    // threads start together, once all the engines are made
+    std::vector<_worker_result>     results(options.threads);
+    std::vector<std::exception_ptr> errors(options.threads);
+    std::latch                      ready{ static_cast<std::ptrdiff_t>(options.threads) };
+    std::vector<std::thread>        workers;
+    for (std::size_t t = 0; t < options.threads; ++t)
+        workers.emplace_back([&, t] {
+            bool started = false;
+            try
+            {
+                auto owned  = shared ? nullptr : make(process * options.threads + t);
+                auto writer = collector.writer();
+                ready.arrive_and_wait();
+                started    = true;
+                results[t] = _drive(shared ? *common : *owned, ordered, options.seconds, *writer);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+                if (!started)
+                    ready.count_down();
+            }
+        });
+    for (auto& w : workers)
+        w.join();
+
+    for (const auto& e : errors)
+        if (e)
+            std::rethrow_exception(e);
+    return results;
+}
+
+// runs all processes, forking if there are more than one
+template <typename Engine, typename Make>
+[[nodiscard]] static std::vector<_worker_result> _run_processes(
+    const _options& options, bool ordered, bool thread_safe, Make make, _collector& collector)
+{
+    if (options.processes == 1)
+        return _run_threads<Engine>(options, 0, ordered, thread_safe, make, collector);
+
+#if UUID_CPP_STRESS_FORK
+    std::vector<std::pair<pid_t, int>> children;
+    for (std::size_t p = 0; p < options.processes; ++p)
+    {
+        int fds[2];
+        if (::pipe(fds) != 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+
+        const auto pid = ::fork();
+        if (pid < 0)
+            throw std::system_error(std::error_code(errno, std::generic_category()));
+        if (pid == 0)
+        {
+            ::close(fds[0]);
+            int status = 0;
+            try
+            {
+                const auto results = _run_threads<Engine>(options, p, ordered, thread_safe, make, collector);
+                const auto bytes   = std::size(results) * sizeof(_worker_result);
+                status = ::write(fds[1], std::data(results), bytes) == static_cast<ssize_t>(bytes) ? 0 : 1;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "process " << p << ": " << e.what() << '\n';
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        ::close(fds[1]);
+        children.emplace_back(pid, fds[0]);
+    }
+
+    std::vector<_worker_result> results;
+    bool                        failed = false;
+    for (const auto& [pid, fd] : children)
+    {
+        std::vector<_worker_result> part(options.threads);
+        const auto                  bytes = std::size(part) * sizeof(_worker_result);
+        std::size_t                 got   = 0;
+        for (ssize_t n; got < bytes && (n = ::read(fd, reinterpret_cast<char*>(std::data(part)) + got, bytes - got)) > 0;)
+            got += static_cast<std::size_t>(n);
+        ::close(fd);
+
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        failed |= got != bytes || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        results.insert(std::end(results), std::begin(part), std::end(part));
+    }
+    if (failed)
+        throw std::runtime_error{ "a child process failed" };
+    return results;
+#else
+    throw std::invalid_argument{ "--processes needs fork()" };
+#endif
+}
+
+struct _engine_case
+{
+    std::string_view name;
+    bool             ordered; // UUIDs of each thread must be strictly increasing
+    std::function<std::vector<_worker_result>(const _options&, const std::string& tag, _collector&)> run;
+};
+
+template <typename Engine, typename Make>
+[[nodiscard]] static _engine_case _make_case(std::string_view name, bool ordered, bool thread_safe, Make make)
+{
+    return { name, ordered, [=](const _options& options, const std::string&, _collector& collector) {
+                return _run_processes<Engine>(options, ordered, thread_safe, make, collector);
+            } };
+}
+
+// shared sequences are named after the run, and removed afterwards;
+// version 1 UUIDs don't sort by time, only their uniqueness is checked
+template <typename Engine>
+[[nodiscard]] static _engine_case _make_shared_case(std::string_view name, std::uint8_t version)
+{
+    return { name, true, [=](const _options& options, const std::string& tag, _collector& collector) {
+                const auto segment = "/" + tag;
+                SharedSequence::remove(segment);
+                try
+                {
+                    const auto make = [segment, version](std::size_t) {
+                        return std::make_unique<Engine>(SharedSequence{ segment, version });
+                    };
+                    auto results = _run_processes<Engine>(options, version != 1, true, make, collector);
+                    SharedSequence::remove(segment);
+                    return results;
+                }
+                catch (...)
+                {
+                    SharedSequence::remove(segment);
+                    throw;
+                }
+            } };
+}
+
+[[nodiscard]] static std::vector<_engine_case> _engine_cases()
+{
+    const auto seed = std::random_device{}();
+    return {
+        _make_case<RandomEngine>("random", false, false, [](std::size_t) { return std::make_unique<RandomEngine>(); }),
+        _make_case<PhiloxEngine>("philox", false, false, [seed](std::size_t worker) {
+            return std::make_unique<PhiloxEngine>(seed, worker); // one stream per thread
+        }),
+        _make_case<SystemEngine>("system", false, true, [](std::size_t) { return std::make_unique<SystemEngine>(); }),
+        _make_case<AddressEngine>("address", false, true, [](std::size_t) { return std::make_unique<AddressEngine>(); }),
+        _make_case<OrderedAddressEngine>("ordered-address", true, true, [](std::size_t) {
+            return std::make_unique<OrderedAddressEngine>();
+        }),
+        _make_case<TimeEngine>("time", true, true, [](std::size_t) { return std::make_unique<TimeEngine>(); }),
+        _make_case<GeneratorService>("pooled", true, true, [](std::size_t) {
+            return std::make_unique<GeneratorService>(TimeEngine{});
+        }),
+        _make_shared_case<SharedAddressEngine>("shared-address", 1),
+        _make_shared_case<SharedOrderedAddressEngine>("shared-ordered-address", 6),
+        _make_shared_case<SharedTimeEngine>("shared-time", 7),
+    };
+}
+
+
+
+// driver //////////////////////////////////////////////////////////////////
+
+[[nodiscard]] static std::vector<std::string> _split_list(std::string_view list)
+{
+    std::vector<std::string> items;
+    while (!list.empty())
+    {
+        const auto comma = list.find(',');
+        items.emplace_back(list.substr(0, comma));
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    }
+    return items;
+}
+
+template <typename T>
+[[nodiscard]] static T _parse_number(std::string_view flag, std::string_view text)
+{
+    T value{};
+    const auto [end, ec] = std::from_chars(std::data(text), std::data(text) + std::size(text), value);
+    if (ec != std::errc{} || end != std::data(text) + std::size(text) || value <= 0)
+        throw std::invalid_argument{ "invalid value for " + std::string{ flag } + ": " + std::string{ text } };
+    return value;
+}
+
+[[nodiscard]] static _options _parse_options(int argc, char** argv)
+{
+    _options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg   = argv[i];
+        const auto             equal = arg.find('=');
+        const auto             flag  = arg.substr(0, equal);
+        const auto             value = equal == std::string_view::npos ? std::string_view{} : arg.substr(equal + 1);
+
+        if (flag == "--engines")
+            options.engines = _split_list(value);
+        else if (flag == "--threads")
+            options.threads = _parse_number<std::size_t>(flag, value);
+        else if (flag == "--processes")
+            options.processes = _parse_number<std::size_t>(flag, value);
+        else if (flag == "--seconds")
+            options.seconds = _parse_number<double>(flag, value);
+        else if (flag == "--collector" && (value == "sort" || value == "hash"))
+            options.collector = value;
+        else if (flag == "--run-size")
+            options.run_size = _parse_number<std::size_t>(flag, value);
+        else if (flag == "--dir" && !value.empty())
+            options.dir = value;
+        else if (flag == "--per-thread" && value.empty())
+            options.per_thread = true;
+        else
+            throw std::invalid_argument{ "unknown option: " + std::string{ arg } };
+    }
+    if (options.processes > 1 && options.collector == "hash")
+        throw std::invalid_argument{ "the hash collector only works within one process, use --collector=sort" };
+    return options;
+}
+
+int main(int argc, char** argv)
+{
+    _options options;
+    try
+    {
+        options = _parse_options(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n\n"
+                  << "usage: " << argv[0] << " [--engines=random,philox,system,address,ordered-address,time,pooled,\n"
+                  << "    shared-address,shared-ordered-address,shared-time]\n"
+                  << "    [--threads=N] [--processes=N] [--seconds=S] [--collector=sort|hash] [--run-size=N]\n"
+                  << "    [--dir=PATH] [--per-thread]\n";
+        return 2;
+    }
+
+    const auto cases = _engine_cases();
+    for (const auto& name : options.engines)
+        if (std::none_of(std::begin(cases), std::end(cases), [&name](const auto& c) { return c.name == name; }))
+        {
+            std::cerr << "unknown engine: " << name << '\n';
+            return 2;
+        }
+
+    std::printf("%-15s %9s %13s %10s %26s %11s %8s\n", "engine", "workers", "ids", "Mid/s",
+        "Mid/s per thread min/avg/max", "duplicates", "order");
+
+    bool failed = false;
+    for (const auto& c : cases)
+    {
+        if (std::find(std::begin(options.engines), std::end(options.engines), c.name) == std::end(options.engines))
+            continue;
+
+#if UUID_CPP_STRESS_FORK
+        const auto tag = "uuid-cpp-stress-" + std::to_string(::getpid()) + "-" + std::string{ c.name };
+#else
+        const auto tag = "uuid-cpp-stress-" + std::string{ c.name };
+#endif
+        const auto workers = std::to_string(options.processes) + "x" + std::to_string(options.threads);
+        try
+        {
+            std::unique_ptr<_collector> collector;
+            if (options.collector == "hash")
+                collector = std::make_unique<_hash_collector>();
+            else
+                collector = std::make_unique<_run_collector>(options.dir / tag, options.run_size);
+
+            const auto results    = c.run(options, tag, *collector);
+            const auto duplicates = collector->duplicates();
+            collector.reset();
+            std::filesystem::remove_all(options.dir / tag);
+
+            std::uint64_t total = 0, violations = 0;
+            double        seconds = 0.0, lowest = 1e300, highest = 0.0, sum = 0.0;
+            for (const auto& r : results)
+            {
+                const auto rate = static_cast<double>(r.count) / r.seconds / 1e6;
+                total += r.count;
+                violations += r.order_violations;
+                seconds = std::max(seconds, r.seconds);
+                lowest  = std::min(lowest, rate);
+                highest = std::max(highest, rate);
+                sum += rate;
+            }
+
+            const auto order = c.ordered ? std::to_string(violations) : std::string{ "-" };
+            std::printf("%-15s %9s %13llu %10.2f %8.2f / %6.2f / %6.2f %11llu %8s\n", std::string{ c.name }.c_str(),
+                workers.c_str(), static_cast<unsigned long long>(total), static_cast<double>(total) / seconds / 1e6, lowest,
+                sum / static_cast<double>(std::size(results)), highest, static_cast<unsigned long long>(duplicates),
+                order.c_str());
+            failed |= duplicates != 0 || violations != 0;
+        }
+        catch (const std::exception& e)
+        {
+            std::filesystem::remove_all(options.dir / tag);
+            std::printf("%-15s %9s error: %s\n", std::string{ c.name }.c_str(), workers.c_str(), e.what());
+            failed = true;
+        }
+        std::fflush(stdout);
+    }
+    return failed ? 1 : 0;
+}
@@ -3,10 +3,26 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace uuid;
 
 const std::regex well_formed_uuid{
@@ -14,6 +30,13 @@ const std::regex well_formed_uuid{
     std::regex_constants::optimize
 };
 
+// ctest runs the suite once per vector level, possibly in parallel: files get a per-run name
+static std::filesystem::path _temp_path(const std::string& name)
+{
+    static const auto run = RandomEngine{}().string();
+    return std::filesystem::temp_directory_path() / (name + "-" + run);
+}
+
 GTEST_TEST(Uuid, Null)
 {
     const Uuid a{}; // default constructed uuid is null
@@ -66,6 +89,7 @@ GTEST_TEST(Uuid, ParseSuccess)
     {
         ASSERT_TRUE(std::regex_match(s, well_formed_uuid)) << "s: " << s;
         EXPECT_NO_THROW(auto _ = parse(s)) << "s: " << s;
+        EXPECT_EQ(try_parse(s), parse(s)) << "s: " << s;
     }
 }
 
@@ -81,6 +105,7 @@ GTEST_TEST(Uuid, ParseFailure)
     {
         ASSERT_FALSE(std::regex_match(s, well_formed_uuid));
         EXPECT_THROW(auto _ = parse(s), std::invalid_argument);
+        EXPECT_FALSE(try_parse(s).has_value());
     }
 }
 
@@ -102,71 +127,1319 @@ GTEST_TEST(Uuid, Builder)
     const uint8_t  node[6] = {};
 }
 
-GTEST_TEST(AddressEngine, UniquenessProperty)
-{ // generated UUIDs must be unique.
-    const auto     iters = 100'000;
-    AddressEngine  gen{};
-    std::set<Uuid> bag{};
+GTEST_TEST(Encoding, Base64RoundTrip)
+{
+    ASSERT_EQ(to_base64(Uuid{}), "AAAAAAAAAAAAAAAAAAAAAA");
+    ASSERT_EQ(to_base64(parse("6ba7b810-9dad-11d1-80b4-00c04fd430c8")), "a6e4EJ2tEdGAtADAT9QwyA");
 
-    for (auto i = 0; i < iters; ++i)
-        bag.insert(gen());
+    RandomEngine gen{};
+    for (auto i = 0; i < 10'000; ++i)
+    {
+        const auto u = gen();
+        const auto s = to_base64(u);
+        ASSERT_EQ(std::size(s), UUID_BASE64_STRING_SIZE);
+        ASSERT_EQ(parse_base64(s), u) << "s: " << s;
+    }
 
-    ASSERT_EQ(std::size(bag), iters);
+    // non-zero padding bits and digits outside of the alphabet
+    ASSERT_FALSE(try_parse_base64("AAAAAAAAAAAAAAAAAAAAAB"));
+    ASSERT_FALSE(try_parse_base64("AAAAAAAAAAAAAAAAAAAAA+"));
+    EXPECT_THROW(auto _ = parse_base64("AAAAAAAAAAA"), std::invalid_argument);
+}
+
+GTEST_TEST(Encoding, Base32RoundTrip)
+{
+    ASSERT_EQ(to_base32(Uuid{}), "00000000000000000000000000");
+
+    RandomEngine gen{};
+    for (auto i = 0; i < 10'000; ++i)
+    {
+        const auto u = gen();
+        const auto s = to_base32(u);
+        ASSERT_EQ(std::size(s), UUID_BASE32_STRING_SIZE);
+        ASSERT_EQ(parse_base32(s), u) << "s: " << s;
+        ASSERT_EQ(parse_base32(s), parse_base32(std::regex_replace(s, std::regex{ "0" }, "o")));
+    }
+
+    // first digit carries only 3 bits
+    ASSERT_FALSE(try_parse_base32("80000000000000000000000000"));
+    ASSERT_FALSE(try_parse_base32("0000000000000000000000000U"));
 }
 
-GTEST_TEST(AddressEngine, IncreasingOrderProperty)
-{ // generated UUIDs must be in strictly increasing order.
-    const auto        iters = 100'000;
-    AddressEngine     gen{};
-    std::vector<Uuid> bag{};
-    bag.reserve(iters);
+GTEST_TEST(Encoding, Base58RoundTrip)
+{
+    ASSERT_EQ(to_base58(Uuid{}), "1111111111111111111111");
+
+    RandomEngine gen{};
+    for (auto i = 0; i < 10'000; ++i)
+    {
+        const auto u = gen();
+        const auto s = to_base58(u);
+        ASSERT_EQ(std::size(s), UUID_BASE58_STRING_SIZE);
+        ASSERT_EQ(parse_base58(s), u) << "s: " << s;
+    }
 
+    // value doesn't fit in 128 bits
+    ASSERT_FALSE(try_parse_base58("zzzzzzzzzzzzzzzzzzzzzz"));
+    ASSERT_FALSE(try_parse_base58("111111111111111111111O"));
+}
+
+GTEST_TEST(Encoding, PreservesOrdering)
+{ // fixed width base32 and base58 strings sort like the bytes.
+    RandomEngine      gen{};
+    std::vector<Uuid> bag(10'000);
+    std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+    std::sort(std::begin(bag), std::end(bag));
+
+    for (std::size_t i = 1; i < std::size(bag); ++i)
+    {
+        ASSERT_LT(to_base32(bag[i - 1]), to_base32(bag[i]));
+        ASSERT_LT(to_base58(bag[i - 1]), to_base58(bag[i]));
+    }
+}
+
+GTEST_TEST(Encoding, Batch)
+{
+    RandomEngine      gen{};
+    std::vector<Uuid> bag(1'000);
+    std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+
+    std::vector<char> text(std::size(bag) * UUID_BASE64_STRING_SIZE);
+    std::vector<Uuid> back(std::size(bag));
+    to_base64_many(bag, text);
+    ASSERT_EQ(try_parse_base64_many(text, back), std::size(bag));
+    ASSERT_EQ(back, bag);
+
+    text.resize(std::size(bag) * UUID_BASE32_STRING_SIZE);
+    to_base32_many(bag, text);
+    ASSERT_EQ(try_parse_base32_many(text, back), std::size(bag));
+    ASSERT_EQ(back, bag);
+
+    text.resize(std::size(bag) * UUID_BASE58_STRING_SIZE);
+    to_base58_many(bag, text);
+    text[10 * UUID_BASE58_STRING_SIZE] = '0'; // not in the alphabet
+    ASSERT_EQ(try_parse_base58_many(text, back), 10);
+}
+
+// 60 bits timestamp of a version 1 UUID, from time_low | time_mid | time_hi_and_version
+static std::uint64_t _version_1_value(const Uuid& u)
+{
+    const auto at = [&u](std::size_t i) { return std::to_integer<std::uint64_t>(u.data()[i]); };
+    return ((at(6) & 0x0f) << 56) | (at(7) << 48) | (at(4) << 40) | (at(5) << 32) | (at(0) << 24) | (at(1) << 16) |
+           (at(2) << 8) | at(3);
+}
+
+GTEST_TEST(AddressEngine, FakeTimeSource)
+{ // repeated and regressing timestamps must still produce increasing timestamps.
+    const auto                iters = 1'000;
+    FakeTimeSource            clock{ 1'000'000, 0 };
+    BasicAddressEngine        gen{ clock };
+    BasicOrderedAddressEngine ordered{ clock };
+    std::vector<Uuid>         bag{};
+    std::vector<Uuid>         ordered_bag{};
+
+    for (auto i = 0; i < iters; ++i)
+    {
+        bag.push_back(gen());
+        ordered_bag.push_back(ordered());
+    }
+    clock.set(0);
     for (auto i = 0; i < iters; ++i)
+    {
         bag.push_back(gen());
+        ordered_bag.push_back(ordered());
+    }
+
+    // version 1 keeps the fields of [RFC 4122], only its timestamps increase
+    ASSERT_EQ(_version_1_value(bag.front()), _version_1_timestamp(1'000'000));
+    for (std::size_t i = 1; i < std::size(bag); ++i)
+        ASSERT_EQ(_version_1_value(bag[i]), _version_1_value(bag[i - 1]) + 1);
+    ASSERT_TRUE(std::all_of(std::cbegin(bag), std::cend(bag), [](const Uuid& u) { return u.version() == 1; }));
+
+    ASSERT_TRUE(std::is_sorted(std::cbegin(ordered_bag), std::cend(ordered_bag)));
+    ASSERT_EQ(std::set<Uuid>(std::cbegin(ordered_bag), std::cend(ordered_bag)).size(), std::size(ordered_bag));
+    ASSERT_TRUE(std::all_of(
+        std::cbegin(ordered_bag), std::cend(ordered_bag), [](const Uuid& u) { return u.version() == 6; }));
+
+    // the same timestamps, version 6 moves the low 12 bits after the version
+    for (std::size_t i = 0; i < std::size(bag); ++i)
+    {
+        const auto high = _big_endian_half(ordered_bag[i], 0);
+        ASSERT_EQ(_version_1_value(bag[i]), ((high >> 16) << 12) | (high & 0xfff));
+    }
+}
 
+GTEST_TEST(TimeEngine, Copies)
+{ // copies keep the node, so they must draw from the same sequence.
+    TimeEngine           time{};
+    OrderedAddressEngine address{};
+    auto                 time_copy    = time;
+    auto                 address_copy = address;
+    std::vector<Uuid>    bag;
+
+    for (auto i = 0; i < 1'000; ++i)
+    {
+        bag.push_back(time());
+        bag.push_back(time_copy());
+    }
+    ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
+    ASSERT_TRUE(std::adjacent_find(std::cbegin(bag), std::cend(bag)) == std::cend(bag));
+
+    bag.clear();
+    for (auto i = 0; i < 1'000; ++i)
+    {
+        bag.push_back(address());
+        bag.push_back(address_copy());
+    }
     ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
+    ASSERT_TRUE(std::adjacent_find(std::cbegin(bag), std::cend(bag)) == std::cend(bag));
+
+    time_copy         = TimeEngine{};
+    time_copy         = time;
+    const auto before = time();
+    ASSERT_LT(before, time_copy());
 }
 
-GTEST_TEST(RandomEngine, UniquenessProperty)
-{ // generated UUIDs must be unique.
-    const auto     iters = 100'000;
-    RandomEngine   gen{};
-    std::set<Uuid> bag{};
+GTEST_TEST(TimeSource, CoarseAndTicker)
+{
+    using namespace std::chrono;
+    const auto reference = SystemTimeSource{}.now();
+    const auto tolerance = duration_cast<nanoseconds>(milliseconds{ 100 }).count();
 
-    for (auto i = 0; i < iters; ++i)
-        bag.insert(gen());
+    const auto coarse = CoarseTimeSource{}.now();
+    ASSERT_LT(coarse > reference ? coarse - reference : reference - coarse, tolerance);
 
-    ASSERT_EQ(std::size(bag), iters);
+    const TickerTimeSource ticker{ milliseconds{ 1 } };
+    const auto             first = ticker.now();
+    ASSERT_LT(first > reference ? first - reference : reference - first, tolerance);
+
+    // the ticker thread might not be scheduled for a while on a loaded machine
+    const auto deadline = steady_clock::now() + seconds{ 5 };
+    while (ticker.now() == first && steady_clock::now() < deadline)
+        std::this_thread::sleep_for(milliseconds{ 1 });
+    ASSERT_GT(ticker.now(), first);
 }
 
+GTEST_TEST(TimeEngine, UniquenessProperty)
+{ // generated UUIDs must be unique and in strictly increasing order, even across threads.
+    const auto        iters = 10'000;
+    TimeEngine        gen{};
+    std::vector<Uuid> bags[4];
 
-GTEST_TEST(SystemEngine, UniquenessProperty)
-{ // generated UUIDs must be unique.
-    const auto     iters = 100'000;
-    SystemEngine   gen{};
-    std::set<Uuid> bag{};
+    std::vector<std::thread> workers;
+    for (auto& bag : bags)
+        workers.emplace_back([&gen, &bag] {
+            for (auto i = 0; i < iters; ++i)
+                bag.push_back(gen());
+        });
+    for (auto& w : workers)
+        w.join();
 
-    for (auto i = 0; i < iters; ++i)
+    std::set<Uuid> all{};
+    for (const auto& bag : bags)
     {
-        const auto [_, unique] = bag.insert(gen());
-        ASSERT_TRUE(unique);
+        ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
+        all.insert(std::cbegin(bag), std::cend(bag));
     }
+    ASSERT_EQ(std::size(all), std::size(bags) * iters);
+}
 
-    ASSERT_EQ(std::size(bag), iters);
+GTEST_TEST(TimeEngine, Reserve)
+{
+    FakeTimeSource    clock{ 1'000'000'000 };
+    BasicTimeEngine   gen{ clock };
+    const auto        before = gen();
+    const UuidRange   range  = gen.reserve(10'000); // spills over the next milliseconds
+    const auto        after  = gen();
+    std::vector<Uuid> bag(std::cbegin(range), std::cend(range));
+
+    ASSERT_EQ(std::size(bag), 10'000);
+    ASSERT_LT(before, range.front());
+    ASSERT_LT(range.back(), after);
+    ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
+    ASSERT_EQ(std::adjacent_find(std::cbegin(bag), std::cend(bag)), std::cend(bag));
+    ASSERT_EQ(range[42], bag[42]);
+
+    // version 7 and [RFC 4122] variant
+    for (const auto& u : bag)
+    {
+        ASSERT_EQ(u.data()[6] >> 4, std::byte{ 7 });
+        ASSERT_EQ(u.data()[8] >> 6, std::byte{ 0b10 });
+    }
 }
 
-// NOTE: current windows implementation does not guarantee this property
-/*
-GTEST_TEST(SystemEngine, IncreasingOrderProperty)
-{ // generated UUIDs must be in strictly increasing order.
-    const auto        iters = 100'000;
-    SystemEngine      gen{};
-    std::vector<Uuid> bag{};
-    bag.reserve(iters);
+GTEST_TEST(TimeEngine, ReserveTooMany)
+{ // an oversized reservation throws and leaves the shared sequence untouched.
+    TimeEngine           time{};
+    OrderedAddressEngine address{};
+    auto                 time_copy    = time;
+    auto                 address_copy = address;
+
+    const auto time_before    = time();
+    const auto address_before = address();
+    ASSERT_THROW((void)time.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+    ASSERT_THROW((void)address.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+    ASSERT_LT(time_before, time_copy());
+    ASSERT_LT(address_before, address_copy());
+}
+
+GTEST_TEST(UuidRange, TimeRange)
+{ // finds the UUIDs generated in a time interval, at the precision of the version.
+    using namespace std::chrono;
+    const std::uint64_t start = 1'700'000'000'000'000'000;
+    const std::uint64_t step  = 70'000;
+    const auto          count = 10'000;
+    const auto          at    = [](std::uint64_t ns) { return system_clock::time_point{ duration_cast<system_clock::duration>(nanoseconds{ ns }) }; };
+
+    static_assert(min_for_time(system_clock::time_point{}) < max_for_time(system_clock::time_point{}));
+    ASSERT_THROW(auto _ = min_for_time(system_clock::now(), 4), std::invalid_argument);
+    ASSERT_THROW(auto _ = min_for_time(system_clock::now(), 1), std::invalid_argument);
+
+    BasicTimeEngine           time{ FakeTimeSource{ start, step } };
+    BasicOrderedAddressEngine address{ FakeTimeSource{ start, step } };
+    for (const auto& [version, ticks] : { std::pair{ 7, 1'000'000 }, std::pair{ 6, 100 } })
+    {
+        std::vector<Uuid> bag(count);
+        for (auto& u : bag)
+            u = (version == 7) ? time() : address();
+        ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
+
+        const auto from = start + 123'456'789;
+        const auto to   = start + 456'789'012;
+        const auto span = time_range(bag, at(from), at(to), version);
+
+        // UUIDs are generated at start + i * step, compared in units of the version
+        std::vector<Uuid> expected;
+        for (auto i = 0; i < count; ++i)
+        {
+            const auto t = (start + i * step) / ticks;
+            if (from / ticks <= t && t <= to / ticks)
+                expected.push_back(bag[i]);
+        }
+        ASSERT_FALSE(expected.empty());
+        ASSERT_TRUE(std::equal(std::cbegin(span), std::cend(span), std::cbegin(expected), std::cend(expected)));
 
+        ASSERT_TRUE(time_range(bag, at(to), at(from), version).empty());
+        ASSERT_EQ(std::size(time_range(bag, at(0), at(start * 2), version)), count);
+        ASSERT_TRUE(time_range({}, at(from), at(to), version).empty());
+    }
+}
+
+GTEST_TEST(UuidRange, Serialization)
+{
+    TimeEngine      gen{};
+    const UuidRange range = gen.reserve(1'000);
+
+    std::array<std::byte, UuidRange::SERIALIZED_SIZE> buffer;
+    range.serialize(buffer);
+    const auto copy = UuidRange::deserialize(buffer);
+    ASSERT_EQ(copy, range);
+    ASSERT_TRUE(std::equal(std::cbegin(copy), std::cend(copy), std::cbegin(range)));
+
+    buffer[0] = std::byte{ 0xf0 }; // unknown version
+    EXPECT_THROW(auto _ = UuidRange::deserialize(buffer), std::invalid_argument);
+
+    // version 1 ranges are only unique, their UUIDs don't sort
+    AddressEngine   address{};
+    const UuidRange address_range = address.reserve(1'000);
+    address_range.serialize(buffer);
+    ASSERT_EQ(UuidRange::deserialize(buffer), address_range);
+    ASSERT_EQ(std::set<Uuid>(std::cbegin(address_range), std::cend(address_range)).size(), 1'000);
+    ASSERT_EQ(_version_1_value(address_range.back()), _version_1_value(address_range.front()) + 999);
+    ASSERT_EQ(address_range[42].version(), 1);
+}
+
+// node and clock sequence fields of time-based UUIDs
+static std::vector<std::byte> _node_of(const Uuid& u)
+{
+    return { u.data() + 8, u.data() + 16 };
+}
+
+GTEST_TEST(Reseed, Explicit)
+{ // copies share their random state until engines are reseeded.
+    RandomEngine random{};
+    TimeEngine   time{};
+    auto         random_copy = random;
+    auto         time_copy   = time;
+
+    ASSERT_EQ(random(), random_copy());
+    ASSERT_EQ(_node_of(time()), _node_of(time_copy()));
+
+    reseed_engines();
+    ASSERT_NE(random(), random_copy());
+    ASSERT_NE(_node_of(time()), _node_of(time_copy()));
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+GTEST_TEST(Reseed, Fork)
+{ // forked children must not repeat the UUIDs of their parent.
+    RandomEngine random{};
+    TimeEngine   time{};
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    const auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+        const Uuid out[] = { random(), time() };
+        const auto _     = ::write(fds[1], out, sizeof(out));
+        ::_exit(0);
+    }
+
+    ::close(fds[1]);
+    Uuid child[2];
+    ASSERT_EQ(::read(fds[0], child, sizeof(child)), static_cast<ssize_t>(sizeof(child)));
+    ::close(fds[0]);
+    ::waitpid(pid, nullptr, 0);
+
+    ASSERT_NE(random(), child[0]);
+    ASSERT_NE(_node_of(time()), _node_of(child[1]));
+}
+
+GTEST_TEST(SharedSequence, MultiProcess)
+{ // time and sequence values never repeat across processes, and increase in each one.
+    const auto processes = 4;
+    const auto iters     = 20'000;
+    const auto name      = "/uuid-cpp-test-" + std::to_string(::getpid());
+    SharedSequence::remove(name);
+
+    // removes the segment even when an assertion returns early, children _exit() past it
+    struct _remove_segment
+    {
+        const std::string& name;
+        ~_remove_segment() { ::shm_unlink(name.c_str()); }
+    } remove_segment{ name };
+
+    std::vector<std::filesystem::path> paths; // named before forking, children write there
+    for (auto p = 0; p < processes; ++p)
+        paths.push_back(_temp_path("uuid-cpp-shared-" + std::to_string(p)));
+
+    std::vector<pid_t> children;
+    for (auto p = 0; p < processes; ++p)
+    {
+        const auto pid = ::fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            try
+            {
+                SharedTimeEngine  gen{ SharedSequence{ name, 7 } };
+                std::vector<Uuid> out(iters);
+                std::generate(std::begin(out), std::end(out), std::ref(gen));
+
+                std::ofstream os{ paths[p], std::ios::binary };
+                os.write(reinterpret_cast<const char*>(std::data(out)), sizeof(Uuid) * iters);
+                ::_exit(os ? 0 : 1);
+            }
+            catch (...)
+            {
+                ::_exit(1);
+            }
+        }
+        children.push_back(pid);
+    }
+
+    for (const auto pid : children)
+    {
+        int status = 0;
+        ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+        ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    std::set<std::vector<std::byte>> values;
+    for (auto p = 0; p < processes; ++p)
+    {
+        std::vector<Uuid> out(iters);
+        std::ifstream{ paths[p], std::ios::binary }.read(reinterpret_cast<char*>(std::data(out)), sizeof(Uuid) * iters);
+        std::filesystem::remove(paths[p]);
+
+        ASSERT_TRUE(std::is_sorted(std::cbegin(out), std::cend(out)));
+        for (const auto& u : out)
+            values.emplace(u.data(), u.data() + 8); // time, version and counter
+    }
+    ASSERT_EQ(std::size(values), processes * iters);
+
+    ASSERT_THROW(SharedSequence(name, 1), std::invalid_argument);
+    ASSERT_THROW(SharedAddressEngine{ SharedSequence(name, 7) }, std::invalid_argument);
+    ASSERT_TRUE(SharedSequence::remove(name));
+    ASSERT_FALSE(SharedSequence::remove(name));
+}
+#endif
+
+GTEST_TEST(PhiloxEngine, KnownAnswers)
+{ // blocks match the reference implementation of Philox4x32-10.
+    using _block = std::array<std::uint32_t, 4>;
+    static_assert(_philox({ 0, 0, 0, 0 }, { 0, 0 }) == _block{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+    ASSERT_EQ(_philox({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }),
+        (_block{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+    ASSERT_EQ(_philox({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }),
+        (_block{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+}
+
+GTEST_TEST(PhiloxEngine, ParallelMatchesSerial)
+{ // any split of the stream gives the same UUIDs.
+    const auto        count = 100'000;
+    std::vector<Uuid> serial(count);
+    PhiloxEngine      gen{ 42, 7 };
+    gen.generate(serial);
+    ASSERT_EQ(gen.position(), count);
+    ASSERT_EQ(std::set<Uuid>(std::cbegin(serial), std::cend(serial)).size(), count);
+
+    for (const std::size_t threads : { 1, 3, 8 })
+    {
+        std::vector<Uuid> parallel(count);
+        parallel_generate(parallel, 42, 7, threads);
+        ASSERT_EQ(parallel, serial);
+    }
+
+    PhiloxEngine skip{ 42, 7 };
+    skip.discard(12'345);
+    ASSERT_EQ(skip(), serial[12'345]);
+    ASSERT_EQ(skip.at(99'999), serial[99'999]);
+    ASSERT_EQ(serial[5].version(), 4);
+    ASSERT_EQ(serial[5].variant(), Variant::rfc4122);
+    ASSERT_NE(PhiloxEngine(42, 8)(), serial[0]);
+    ASSERT_NE(PhiloxEngine(43, 7)(), serial[0]);
+}
+
+
+
+GTEST_TEST(EngineStats, CountsGeneration)
+{
+    const auto before = stats_snapshot(EngineKind::random);
+
+    const auto   iters = 1'000;
+    RandomEngine gen{};
+    std::thread  worker{ [iters] {
+        RandomEngine local{};
+        for (auto i = 0; i < iters; ++i)
+            auto _ = local();
+    } };
     for (auto i = 0; i < iters; ++i)
-        bag.push_back(gen());
+        auto _ = gen();
+    worker.join();
+
+    const auto after = stats_snapshot(EngineKind::random);
+    if (!stats_enabled())
+    {
+        ASSERT_EQ(after.generated, 0);
+        return;
+    }
+
+    // counts of terminated threads must not be lost
+    ASSERT_EQ(after.generated - before.generated, 2 * iters);
+    ASSERT_EQ(after.entropy_refills - before.entropy_refills, 2);
+
+    std::uint64_t samples = 0;
+    for (std::size_t i = 0; i < std::size(after.latency); ++i)
+        samples += after.latency[i] - before.latency[i];
+    ASSERT_EQ(samples, 2 * iters);
+}
+
+GTEST_TEST(EngineStats, ClockBacksteps)
+{ // a clock going back is counted once, a counter running out once per block.
+    const auto      before = stats_snapshot(EngineKind::time);
+    FakeTimeSource  clock{ 1'000'000'000, 0 };
+    BasicTimeEngine gen{ clock };
+
+    (void)gen();
+    clock.set(500'000'000);
+    (void)gen();
+    clock.set(2'000'000'000);
+    (void)gen();
+    (void)gen.reserve(5'000); // the 12 bits counter spills into the next millisecond
+
+    const auto after = stats_snapshot(EngineKind::time);
+    if (!stats_enabled())
+    {
+        ASSERT_EQ(after.clock_backsteps, 0);
+        return;
+    }
+    ASSERT_EQ(after.clock_backsteps - before.clock_backsteps, 1);
+    ASSERT_EQ(after.counter_overflows - before.counter_overflows, 1);
+}
+
+// minimal eagerly started coroutine, enough to drive awaiters
+struct _detached_task
+{
+    struct promise_type
+    {
+        _detached_task      get_return_object() noexcept { return {}; }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void() noexcept {}
+        [[noreturn]] void   unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+_detached_task _consume(GeneratorService& service, std::vector<Uuid>& bag, std::size_t n, std::atomic<bool>& done)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        bag.push_back(co_await service.async_pop());
+    done.store(true);
+    done.notify_one();
+}
+
+GTEST_TEST(GeneratorService, UniquenessProperty)
+{ // UUIDs handed out to concurrent consumers must be unique.
+    const auto       iters = 20'000;
+    GeneratorService service{ RandomEngine{}, 256 };
+
+    std::vector<Uuid>        bags[4];
+    std::vector<std::thread> workers;
+    for (auto& bag : bags)
+        workers.emplace_back([&service, &bag] {
+            for (auto i = 0; i < iters; ++i)
+                bag.push_back(service.pop());
+        });
+    for (auto& w : workers)
+        w.join();
+
+    std::set<Uuid> all{};
+    for (const auto& bag : bags)
+        all.insert(std::cbegin(bag), std::cend(bag));
+    ASSERT_EQ(std::size(all), std::size(bags) * iters);
+}
 
+GTEST_TEST(GeneratorService, Coroutine)
+{ // consumers suspend while the ring is empty, and are resumed after the refill.
+    const auto        iters = 10'000;
+    GeneratorService  service{ TimeEngine{}, 128 };
+    std::vector<Uuid> bag;
+    std::atomic<bool> done{ false };
+
+    _consume(service, bag, iters, done);
+    done.wait(false);
+
+    ASSERT_EQ(std::size(bag), iters);
     ASSERT_TRUE(std::is_sorted(std::cbegin(bag), std::cend(bag)));
 }
-*/
\ No newline at end of file
+
+GTEST_TEST(GeneratorService, EngineFailure)
+{ // errors of the engine are reported to consumers.
+    GeneratorService service{ [] () -> Uuid { throw std::runtime_error{ "no entropy" }; } };
+    EXPECT_THROW(auto _ = service.pop(), std::runtime_error);
+}
+
+GTEST_TEST(GeneratorService, Reseed)
+{ // UUIDs drawn before a reseed are never handed out after it.
+    std::mutex        mtx;
+    std::set<Uuid>    drawn_before;
+    std::atomic<bool> reseeding{ false };
+    PhiloxEngine      engine{ 42 };
+
+    GeneratorService service{ std::function<void(std::span<Uuid>)>{ [&](std::span<Uuid> out) {
+                                  engine.generate(out);
+                                  if (!reseeding.load())
+                                  {
+                                      const std::scoped_lock lock{ mtx };
+                                      drawn_before.insert(std::cbegin(out), std::cend(out));
+                                  }
+                              } },
+        256, 0 };
+    (void)service.pop();
+    while (service.size() < 128)
+        std::this_thread::yield();
+
+    reseeding.store(true);
+    reseed_engines();
+    for (auto i = 0; i < 1'000; ++i)
+    {
+        const auto             u = service.pop();
+        const std::scoped_lock lock{ mtx };
+        ASSERT_FALSE(drawn_before.contains(u));
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+GTEST_TEST(GeneratorService, Fork)
+{ // children get no UUIDs from the ring copied from their parent.
+    auto service = std::make_unique<GeneratorService>(RandomEngine{}, 256);
+    (void)service->pop();
+
+    const auto pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+    {
+        bool ok = !service->try_pop().has_value();
+        try
+        {
+            (void)service->pop();
+            ok = false;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        service.reset(); // must not wait for the thread of the parent
+        ::_exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    (void)service->pop();
+}
+#endif
+
+GTEST_TEST(Interner, DenseHandles)
+{ // handles are dense, stable, and map back to the interned UUIDs.
+    const auto iters = 50'000;
+    Interner   interner{ iters };
+    TimeEngine engine{};
+
+    std::vector<Uuid> samples(iters);
+    for (auto& u : samples)
+        u = engine();
+
+    std::vector<Interner::handle_type> handles(iters);
+    interner.intern_many(samples, handles);
+    ASSERT_EQ(interner.size(), iters);
+
+    std::vector<bool> seen(iters, false);
+    for (std::size_t i = 0; i < iters; ++i)
+    {
+        ASSERT_LT(handles[i], iters);
+        ASSERT_FALSE(seen[handles[i]]);
+        seen[handles[i]] = true;
+
+        ASSERT_EQ(interner[handles[i]], samples[i]);
+        ASSERT_EQ(interner.intern(samples[i]), handles[i]);
+        ASSERT_EQ(interner.find(samples[i]), handles[i]);
+    }
+    ASSERT_FALSE(interner.find(Uuid{}).has_value());
+    ASSERT_THROW(auto _ = interner.intern(Uuid{}), std::length_error);
+    ASSERT_THROW(auto _ = interner.intern(Uuid{}), std::length_error);
+    ASSERT_EQ(interner.size(), iters); // failed inserts don't count
+
+    // rejected before the storage is allocated
+    ASSERT_THROW(Interner{ std::size_t{ 1 } << 33 }, std::invalid_argument);
+}
+
+GTEST_TEST(Interner, Concurrent)
+{ // concurrent inserts of overlapping sets agree on the handles, readers only see stored UUIDs.
+    const auto iters = 20'000;
+    Interner   interner{ iters };
+    TimeEngine engine{};
+
+    std::vector<Uuid> samples(iters);
+    for (auto& u : samples)
+        u = engine();
+    const std::set<Uuid> expected(std::cbegin(samples), std::cend(samples));
+
+    std::atomic<bool> done{ false };
+    std::atomic<bool> torn{ false };
+    std::thread       reader{ [&] {
+        while (!done.load())
+            if (const auto values = interner.values(); !values.empty() && !expected.contains(values.back()))
+                torn.store(true);
+    } };
+
+    std::vector<Interner::handle_type> handles[4];
+    std::vector<std::thread>           workers;
+    for (auto& h : handles)
+        workers.emplace_back([&interner, &samples, &h] {
+            for (const auto& u : samples)
+                h.push_back(interner.intern(u));
+        });
+    for (auto& w : workers)
+        w.join();
+    done.store(true);
+    reader.join();
+    ASSERT_FALSE(torn.load());
+
+    ASSERT_EQ(interner.size(), iters);
+    for (const auto& h : handles)
+        ASSERT_EQ(h, handles[0]);
+
+    const auto values = interner.values();
+    ASSERT_EQ(std::set<Uuid>(std::cbegin(values), std::cend(values)).size(), iters);
+}
+
+GTEST_TEST(Index, OrderedSet)
+{ // behaves as std::set through splits, unlinked leaves and their reuse.
+    RandomEngine      gen{};
+    std::vector<Uuid> samples(20'000);
+    std::generate(std::begin(samples), std::end(samples), std::ref(gen));
+
+    UuidIndex      index;
+    std::set<Uuid> expected;
+    const auto     check = [&index, &expected] {
+        ASSERT_EQ(index.size(), std::size(expected));
+        std::vector<Uuid> all;
+        index.for_each([&all](const Uuid& u) { all.push_back(u); });
+        ASSERT_TRUE(std::equal(std::cbegin(all), std::cend(all), std::cbegin(expected), std::cend(expected)));
+    };
+
+    for (std::size_t round = 0; round < 2; ++round)
+    {
+        for (const auto& u : samples)
+        {
+            ASSERT_TRUE(index.insert(u));
+            expected.insert(u);
+        }
+        ASSERT_FALSE(index.insert(samples[0]));
+        check();
+
+        for (std::size_t i = 0; i < std::size(samples); i += 2)
+        {
+            ASSERT_TRUE(index.erase(samples[i]));
+            expected.erase(samples[i]);
+        }
+        ASSERT_FALSE(index.erase(samples[0]));
+        check();
+        for (std::size_t i = 0; i < 100; ++i)
+            ASSERT_EQ(index.contains(samples[i]), i % 2 == 1);
+
+        // bounds are included, and fall between keys as well
+        const auto lo = *std::next(std::cbegin(expected), 100);
+        const auto hi = *std::next(std::cbegin(expected), 5'000);
+        std::vector<Uuid> some;
+        index.for_each(lo, hi, [&some](const Uuid& u) { some.push_back(u); });
+        ASSERT_EQ(std::size(some), 4'901);
+        ASSERT_EQ(some.front(), lo);
+        ASSERT_EQ(some.back(), hi);
+        index.for_each(hi, lo, [](const Uuid&) { FAIL(); });
+
+        for (const auto& u : samples)
+            index.erase(u);
+        expected.clear();
+        check();
+    }
+}
+
+GTEST_TEST(Index, TimeRangeAndExpiry)
+{ // scans by time find the same UUIDs as time_range(), and can erase them.
+    using namespace std::chrono;
+    const std::uint64_t start = 1'700'000'000'000'000'000;
+    const auto          at    = [](std::uint64_t ns) { return system_clock::time_point{ duration_cast<system_clock::duration>(nanoseconds{ ns }) }; };
+
+    BasicTimeEngine   gen{ FakeTimeSource{ start, 70'000 } };
+    std::vector<Uuid> bag(20'000);
+    std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+
+    UuidIndex index;
+    for (const auto& u : bag)
+        index.insert(u);
+
+    const auto        from     = at(start + 123'456'789);
+    const auto        to       = at(start + 456'789'012);
+    const auto        expected = time_range(bag, from, to);
+    std::vector<Uuid> found;
+    index.for_each_in_time(from, to, [&found](const Uuid& u) { found.push_back(u); });
+    ASSERT_FALSE(expected.empty());
+    ASSERT_TRUE(std::equal(std::cbegin(found), std::cend(found), std::cbegin(expected), std::cend(expected)));
+
+    // expiry of everything older than to
+    index.for_each_in_time(at(0), to, [&index](const Uuid& u) { ASSERT_TRUE(index.erase(u)); });
+    const auto kept = std::size(bag) - std::size(time_range(bag, at(0), to));
+    ASSERT_EQ(index.size(), kept);
+    ASSERT_FALSE(index.contains(bag.front()));
+    ASSERT_TRUE(index.contains(bag.back()));
+}
+
+GTEST_TEST(Index, Concurrent)
+{ // writers insert and expire time-ordered UUIDs while readers scan them in order.
+    constexpr std::size_t writers = 4;
+    constexpr std::size_t iters   = 20'000;
+    constexpr std::size_t window  = 1'000;
+
+    UuidIndex                      index;
+    std::atomic<bool>              done{ false };
+    std::vector<std::vector<Uuid>> kept(writers);
+    std::vector<std::thread>       threads;
+    for (auto& k : kept)
+        threads.emplace_back([&index, &k] {
+            TimeEngine        gen{};
+            std::vector<Uuid> live;
+            for (std::size_t i = 0; i < iters; ++i)
+            {
+                live.push_back(gen());
+                ASSERT_TRUE(index.insert(live.back()));
+                if (i >= window)
+                {
+                    ASSERT_TRUE(index.erase(live[i - window]));
+                }
+            }
+            k.assign(std::cend(live) - window, std::cend(live));
+        });
+
+    std::size_t scans = 0;
+    std::thread reader{ [&index, &done, &scans] {
+        while (!done.load())
+        {
+            std::vector<Uuid> seen;
+            index.for_each([&seen](const Uuid& u) { seen.push_back(u); });
+            ASSERT_TRUE(std::adjacent_find(std::cbegin(seen), std::cend(seen),
+                            [](const Uuid& a, const Uuid& b) { return !(a < b); }) == std::cend(seen));
+            ++scans;
+        }
+    } };
+
+    for (auto& t : threads)
+        t.join();
+    done.store(true);
+    reader.join();
+    ASSERT_GT(scans, 0);
+
+    ASSERT_EQ(index.size(), writers * window);
+    std::set<Uuid> expected;
+    for (const auto& k : kept)
+        for (const auto& u : k)
+        {
+            ASSERT_TRUE(index.contains(u));
+            expected.insert(u);
+        }
+    std::vector<Uuid> all;
+    index.for_each([&all](const Uuid& u) { all.push_back(u); });
+    ASSERT_TRUE(std::equal(std::cbegin(all), std::cend(all), std::cbegin(expected), std::cend(expected)));
+}
+
+template <typename F>
+static void _check_filter(const F& filter, const std::vector<Uuid>& members, double max_false_positives,
+    std::vector<Uuid> others = {})
+{
+    for (const auto& u : members)
+        ASSERT_TRUE(filter.contains(u));
+    // one short of the batches, so that the probes end with a partial one
+    const auto tested      = std::span{ members }.subspan(1);
+    auto       member_hits = std::make_unique<bool[]>(std::size(tested));
+    ASSERT_EQ(filter.contains_many(tested, { member_hits.get(), std::size(tested) }), std::size(tested));
+
+    if (others.empty())
+    {
+        RandomEngine gen{};
+        others.resize(100'000);
+        std::generate(std::begin(others), std::end(others), std::ref(gen));
+    }
+    const auto iters = std::size(others);
+
+    auto       hits  = std::make_unique<bool[]>(iters);
+    const auto found = filter.contains_many(others, { hits.get(), iters });
+    for (std::size_t i = 0; i < iters; ++i)
+        ASSERT_EQ(hits[i], filter.contains(others[i]));
+    ASSERT_LT(found, iters * max_false_positives);
+}
+
+GTEST_TEST(Filter, NoFalseNegatives)
+{ // members are always found, others only rarely, even the next ones of the same time-based engine.
+    TimeEngine        engine{};
+    std::vector<Uuid> members(50'000);
+    std::vector<Uuid> later(200'000);
+    std::generate(std::begin(members), std::end(members), std::ref(engine));
+    std::generate(std::begin(later), std::end(later), std::ref(engine));
+
+    // about 1.3% and 0.4%, the bounds are more than 7 standard deviations away
+    _check_filter(BloomFilter{ members }, members, 0.015);
+    _check_filter(BloomFilter{ members }, members, 0.015, later);
+    _check_filter(XorFilter{ members }, members, 0.006);
+    _check_filter(XorFilter{ members }, members, 0.006, later);
+}
+
+GTEST_TEST(Filter, Serialization)
+{ // serialized filters can be queried in place.
+    RandomEngine      gen{};
+    std::vector<Uuid> members(10'000);
+    std::generate(std::begin(members), std::end(members), std::ref(gen));
+
+    const BloomFilter bloom{ members };
+    const XorFilter   xor8{ members };
+
+    struct alignas(FILTER_BUFFER_ALIGNMENT) _chunk
+    {
+        std::byte bytes[FILTER_BUFFER_ALIGNMENT];
+    };
+    std::vector<_chunk> buffer(std::max(bloom.serialized_size(), xor8.serialized_size()) / sizeof(_chunk) + 1);
+    const auto          bytes = std::as_writable_bytes(std::span{ buffer });
+
+    bloom.serialize(bytes);
+    _check_filter(BloomFilter::view(bytes), members, 0.02);
+    ASSERT_THROW(auto _ = XorFilter::view(bytes), std::invalid_argument);
+
+    xor8.serialize(bytes);
+    _check_filter(XorFilter::view(bytes), members, 0.01);
+    ASSERT_THROW(auto _ = BloomFilter::view(bytes), std::invalid_argument);
+    ASSERT_THROW(auto _ = XorFilter::view(bytes.subspan(1)), std::invalid_argument);
+}
+
+GTEST_TEST(Guid, ByteOrder)
+{ // fields of the timestamp are swapped to little-endian, scalar and batch alike.
+    constexpr auto u = [] {
+        std::array<std::byte, 16> bytes{};
+        for (std::size_t i = 0; i < std::size(bytes); ++i)
+            bytes[i] = static_cast<std::byte>(i * 0x11);
+        return Uuid{ bytes };
+    }();
+    constexpr auto g = to_guid_bytes(u);
+    static_assert(from_guid_bytes(g) == u);
+    ASSERT_EQ(u, parse("00112233-4455-6677-8899-aabbccddeeff"));
+    ASSERT_EQ(g, (std::array<std::byte, 16>{ std::byte{ 0x33 }, std::byte{ 0x22 }, std::byte{ 0x11 }, std::byte{ 0x00 },
+                     std::byte{ 0x55 }, std::byte{ 0x44 }, std::byte{ 0x77 }, std::byte{ 0x66 },
+                     std::byte{ 0x88 }, std::byte{ 0x99 }, std::byte{ 0xaa }, std::byte{ 0xbb },
+                     std::byte{ 0xcc }, std::byte{ 0xdd }, std::byte{ 0xee }, std::byte{ 0xff } }));
+
+    RandomEngine      gen{};
+    std::vector<Uuid> bag(37); // odd, to cover the tail of the vector loops
+    std::generate(std::begin(bag), std::end(bag), std::ref(gen));
+    auto swapped = bag;
+    swap_guid_order(swapped);
+    for (std::size_t i = 0; i < std::size(bag); ++i)
+        ASSERT_EQ(swapped[i], Uuid{ to_guid_bytes(bag[i]) });
+    swap_guid_order(swapped);
+    ASSERT_EQ(swapped, bag);
+}
+
+GTEST_TEST(Guid, SqlServerOrder)
+{ // node bytes are the most significant, then clock sequence, then the timestamp backwards.
+    std::vector<Uuid> bag;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        std::array<std::byte, 16> bytes{};
+        bytes[i] = std::byte{ 1 };
+        bag.emplace_back(bytes);
+    }
+    std::sort(std::begin(bag), std::end(bag), SqlServerLess{});
+
+    const std::size_t expected[] = { 0, 1, 2, 3, 4, 5, 6, 7, 9, 8, 15, 14, 13, 12, 11, 10 };
+    for (std::size_t i = 0; i < std::size(bag); ++i)
+        ASSERT_EQ(bag[i].data()[expected[i]], std::byte{ 1 }) << i;
+}
+
+GTEST_TEST(Validate, ClassifyAndValidate)
+{ // engines produce UUIDs of the expected variant and version.
+    RandomEngine random{};
+    TimeEngine   time{};
+
+    std::vector<Uuid> samples(1001);
+    for (std::size_t i = 0; i < std::size(samples); ++i)
+        samples[i] = (i % 3 == 0) ? time() : random();
+    for (std::size_t i = 0; i < std::size(samples); i += 7)
+        samples[i].data()[8] &= std::byte{ 0x7f }; // NCS variant
+    ASSERT_EQ(samples[1].version(), 4);
+    ASSERT_EQ(samples[3].version(), 7);
+    ASSERT_EQ(samples[1].variant(), Variant::rfc4122);
+    ASSERT_EQ(samples[0].variant(), Variant::ncs);
+
+    std::vector<std::uint8_t> versions(std::size(samples));
+    const auto                counts = classify_many(samples, versions);
+    ASSERT_EQ(counts[7], 334);
+    ASSERT_EQ(counts[4], 667);
+    for (std::size_t i = 0; i < std::size(samples); ++i)
+        ASSERT_EQ(versions[i], samples[i].version());
+
+    std::vector<std::uint64_t> invalid((std::size(samples) + 63) / 64);
+    ASSERT_EQ(validate_many(samples, UUID_RFC_VERSIONS, invalid), 143);
+    ASSERT_EQ(validate_many(samples, 1 << 4, invalid), 143 + 334 - 48);
+    for (std::size_t i = 0; i < std::size(samples); ++i)
+    {
+        const bool bad = samples[i].variant() != Variant::rfc4122 || samples[i].version() != 4;
+        ASSERT_EQ(((invalid[i / 64] >> (i % 64)) & 1) != 0, bad);
+    }
+}
+
+#if __cpp_lib_format || UUID_CPP_WITH_FMT
+GTEST_TEST(Format, Specs)
+{ // format specs select case, hyphens and decorations.
+    const auto u = parse("0123abcd-4567-89ef-0123-456789abcdef");
+#if __cpp_lib_format
+    using std::format;
+#else
+    using fmt::format;
+#endif
+    ASSERT_EQ(format("{}", u), "0123abcd-4567-89ef-0123-456789abcdef");
+    ASSERT_EQ(format("{:X}", u), "0123ABCD-4567-89EF-0123-456789ABCDEF");
+    ASSERT_EQ(format("{:n}", u), "0123abcd456789ef0123456789abcdef");
+    ASSERT_EQ(format("{:b}", u), "{0123abcd-4567-89ef-0123-456789abcdef}");
+    ASSERT_EQ(format("{:u}", u), "urn:uuid:0123abcd-4567-89ef-0123-456789abcdef");
+    ASSERT_EQ(format("{:bnX}", u), "{0123ABCD456789EF0123456789ABCDEF}");
+    ASSERT_EQ(format("id={} end", u), "id=" + u.string() + " end");
+}
+#endif
+
+GTEST_TEST(Scan, MatchesRegex)
+{ // finds the same UUIDs as a regex, in noisy text.
+    RandomEngine      gen{};
+    std::vector<Uuid> expected;
+    std::string       text;
+    for (auto i = 0; i < 2'000; ++i)
+    {
+        const auto u     = gen();
+        auto       upper = u.string();
+        std::transform(std::cbegin(upper), std::cend(upper), std::begin(upper), [](char c) { return static_cast<char>(std::toupper(c)); });
+
+        switch (i % 5)
+        {
+            case 0: text += "[req " + u.string() + "] ok\n"; break;
+            case 1: text += "id=" + upper + ",x"; break;
+            case 2: text += "0" + u.string() + " too long "; continue;
+            case 3: text += u.string().substr(0, 35) + "g not hex"; continue;
+            default: text += "--------" + u.string(); break;
+        }
+        expected.push_back(u);
+    }
+
+    std::vector<Uuid>        found;
+    std::vector<std::size_t> offsets;
+    const auto               count = for_each_uuid(text, [&](const Uuid& u, std::size_t offset) {
+        found.push_back(u);
+        offsets.push_back(offset);
+    });
+    ASSERT_EQ(count, std::size(expected));
+    ASSERT_EQ(found, expected);
+
+    const std::regex delimited{ "(^|[^[:xdigit:]])([[:xdigit:]]{8}-[[:xdigit:]]{4}-[[:xdigit:]]{4}-[[:xdigit:]]{4}-[[:xdigit:]]{12})(?![[:xdigit:]])" };
+    std::size_t      i = 0;
+    for (auto it = std::sregex_iterator{ std::cbegin(text), std::cend(text), delimited }; it != std::sregex_iterator{}; ++it, ++i)
+    {
+        ASSERT_LT(i, std::size(offsets));
+        ASSERT_EQ(static_cast<std::size_t>(it->position(2)), offsets[i]);
+    }
+    ASSERT_EQ(i, std::size(offsets));
+}
+
+GTEST_TEST(Scan, EndOfText)
+{ // never reads past the text, at every alignment of an UUID ending it, whole or cut short.
+    const auto u     = RandomEngine{}();
+    const auto check = [](const std::string& text) {
+        const auto buffer = std::make_unique<char[]>(std::size(text)); // no terminator
+        std::copy(std::cbegin(text), std::cend(text), buffer.get());
+
+        std::vector<Uuid> found;
+        for_each_uuid(std::string_view{ buffer.get(), std::size(text) }, [&](const Uuid& v) { found.push_back(v); });
+        return found;
+    };
+
+    for (std::size_t prefix = 0; prefix < 80; ++prefix)
+    {
+        const std::string text = std::string(prefix, 'z') + u.string();
+        ASSERT_EQ(check(text), std::vector<Uuid>{ u }) << prefix;
+        ASSERT_TRUE(check(text.substr(0, std::size(text) - 1)).empty()) << prefix;
+    }
+}
+
+GTEST_TEST(Scan, File)
+{ // scans memory mapped files.
+    RandomEngine      gen{};
+    std::vector<Uuid> expected(1'000);
+    std::generate(std::begin(expected), std::end(expected), std::ref(gen));
+
+    const auto path = _temp_path("uuid-cpp-scan-test.log");
+    {
+        std::ofstream os{ path, std::ios::binary };
+        for (const auto& u : expected)
+            os << "event " << u.string() << " done\n";
+    }
+
+    std::vector<Uuid> found;
+    for_each_uuid_in_file(path, [&](const Uuid& u) { found.push_back(u); });
+    std::filesystem::remove(path);
+    ASSERT_EQ(found, expected);
+
+    ASSERT_THROW(for_each_uuid_in_file(path, [](const Uuid&) {}), std::system_error);
+}
+
+GTEST_TEST(Convert, RoundTrip)
+{ // converts text to binary and back, across many small chunks.
+    RandomEngine      gen{};
+    std::vector<Uuid> expected(2'000);
+    std::generate(std::begin(expected), std::end(expected), std::ref(gen));
+
+    const auto text   = _temp_path("uuid-cpp-convert-test.txt");
+    const auto binary = _temp_path("uuid-cpp-convert-test.bin");
+    const auto back   = _temp_path("uuid-cpp-convert-test.out");
+
+    std::vector<ConvertError> errors;
+    {
+        std::ofstream os{ text, std::ios::binary };
+        std::size_t   line = 0;
+        for (std::size_t i = 0; i < std::size(expected); ++i)
+        {
+            if (i % 300 == 7)
+            {
+                errors.push_back({ ++line, static_cast<std::size_t>(os.tellp()) });
+                os << "not-an-uuid\n";
+            }
+            if (i % 500 == 11)
+            {
+                ++line;
+                os << "\r\n";
+            }
+            ++line;
+            os << expected[i].string() << (i % 2 ? "\r\n" : "\n");
+        }
+    }
+
+    const ConvertOptions options{ .threads = 4, .chunk_size = 1'000, .window = 3 };
+    const auto           encoded = convert_file(text, binary, ConvertDirection::text_to_binary, options);
+    EXPECT_EQ(encoded.converted, std::size(expected));
+    EXPECT_EQ(encoded.errors, errors);
+    ASSERT_EQ(std::filesystem::file_size(binary), std::size(expected) * sizeof(Uuid));
+
+    const auto decoded = convert_file(binary, back, ConvertDirection::binary_to_text, options);
+    EXPECT_EQ(decoded.converted, std::size(expected));
+    EXPECT_TRUE(decoded.errors.empty());
+
+    std::vector<Uuid> found;
+    {
+        std::ifstream is{ back };
+        for (std::string line; std::getline(is, line);)
+            found.push_back(parse(line));
+    }
+    EXPECT_EQ(found, expected);
+
+    { // truncated record at the end
+        std::ofstream os{ binary, std::ios::binary | std::ios::app };
+        os << "tail";
+    }
+    const auto truncated = convert_file(binary, back, ConvertDirection::binary_to_text, options);
+    EXPECT_EQ(truncated.converted, std::size(expected));
+    EXPECT_EQ(truncated.errors, (std::vector<ConvertError>{ { std::size(expected) + 1, std::size(expected) * sizeof(Uuid) } }));
+
+    for (const auto& p : { text, binary, back })
+        std::filesystem::remove(p);
+    ASSERT_THROW(convert_file(text, binary, ConvertDirection::text_to_binary), std::system_error);
+}
+
+GTEST_TEST(Dispatch, Levels)
+{ // every set of vector kernels the processor supports agrees with the scalar code.
+    for (std::size_t l = 0; l < SIMD_LEVEL_COUNT; ++l)
+    {
+        const auto level = static_cast<SimdLevel>(l);
+        ASSERT_EQ(try_parse_simd_level(to_string(level)), level);
+    }
+    ASSERT_FALSE(try_parse_simd_level("mmx").has_value());
+    ASSERT_TRUE(simd_supported(SimdLevel::scalar));
+    ASSERT_TRUE(simd_supported(detected_simd_level()));
+
+    RandomEngine      gen{};
+    std::vector<Uuid> samples(203);
+    std::generate(std::begin(samples), std::end(samples), std::ref(gen));
+    for (std::size_t i = 0; i < std::size(samples); i += 5)
+        samples[i].data()[8] &= std::byte{ 0x7f };
+
+    std::string text;
+    for (std::size_t i = 0; i < std::size(samples); ++i)
+        text += samples[i].string() + (i % 3 ? " - " : "-0");
+
+    // everything the kernels compute, for a given level
+    const auto run = [&] {
+        std::vector<std::string> out;
+        for (const auto& u : samples)
+            out.push_back(u.string() + to_base64(u) + to_base32(u));
+
+        std::vector<std::uint8_t>  versions(std::size(samples));
+        std::vector<std::uint64_t> invalid((std::size(samples) + 63) / 64);
+        classify_many(samples, versions);
+        validate_many(samples, 1 << 4, invalid);
+        out.emplace_back(std::begin(versions), std::end(versions));
+        for (const auto w : invalid)
+            out.push_back(std::to_string(w));
+
+        for_each_uuid(text, [&out](const Uuid& u, std::size_t offset) {
+            out.push_back(u.string() + "@" + std::to_string(offset));
+        });
+
+        auto guids = samples;
+        swap_guid_order(guids);
+        for (const auto& u : guids)
+            out.push_back(u.string());
+        for (const auto& u : samples)
+            out.push_back(parse_base64(to_base64(u)).string());
+
+        const BloomFilter filter{ std::span<const Uuid>{ samples }.first(100) };
+        std::vector<char> found(std::size(samples));
+        filter.contains_many(samples, std::span<bool>{ reinterpret_cast<bool*>(std::data(found)), std::size(found) });
+        out.emplace_back(std::begin(found), std::end(found));
+
+        std::vector<std::uint32_t> shards(std::size(samples));
+        for (const auto method : { ShardMethod::jump, ShardMethod::fast_range })
+        {
+            shard_many(samples, 1'000, shards, method);
+            for (const auto s : shards)
+                out.push_back(std::to_string(s));
+        }
+        return out;
+    };
+
+    const auto initial = simd_level();
+    set_simd_level(SimdLevel::scalar);
+    const auto expected = run();
+    for (std::size_t l = 0; l < SIMD_LEVEL_COUNT; ++l)
+    {
+        const auto level = static_cast<SimdLevel>(l);
+        if (!simd_supported(level))
+        {
+            ASSERT_THROW(set_simd_level(level), std::invalid_argument);
+            continue;
+        }
+        set_simd_level(level);
+        ASSERT_EQ(simd_level(), level);
+        ASSERT_EQ(run(), expected) << to_string(level);
+    }
+    set_simd_level(initial);
+}
+
+GTEST_TEST(Shard, JumpAndFastRange)
+{ // shards are uniform, and jump hash only moves keys to the new shard.
+    RandomEngine      gen{};
+    std::vector<Uuid> samples(1 << 16);
+    std::generate(std::begin(samples), std::end(samples), std::ref(gen));
+
+    for (const auto& u : std::span{ samples }.first(1000))
+        for (std::uint32_t n = 1; n < 200; ++n)
+        {
+            const auto before = shard(u, n);
+            const auto after  = shard(u, n + 1);
+            ASSERT_LT(before, n);
+            ASSERT_TRUE(after == before || after == n);
+        }
+
+    // time-based UUIDs of one engine only differ in their low time and counter bits
+    TimeEngine    time{};
+    AddressEngine address{};
+    for (const auto& engine : { std::function<Uuid()>{ std::ref(gen) }, std::function<Uuid()>{ std::ref(time) },
+             std::function<Uuid()>{ std::ref(address) } })
+    {
+        std::generate(std::begin(samples), std::end(samples), engine);
+        for (const auto method : { ShardMethod::jump, ShardMethod::fast_range })
+        {
+            std::vector<std::uint32_t> shards(std::size(samples) - 3);
+            shard_many(std::span{ samples }.first(std::size(shards)), 1024, shards, method);
+
+            std::vector<std::size_t> counts(1024);
+            for (std::size_t i = 0; i < std::size(shards); ++i)
+            {
+                ASSERT_EQ(shards[i], shard(samples[i], 1024, method));
+                ++counts[shards[i]];
+            }
+            // 64 on average, with a standard deviation of 8: the largest of 1024 shards
+            // is about 92, the bounds are 7 deviations away to keep 6 runs from flaking
+            ASSERT_GT(*std::min_element(std::begin(counts), std::end(counts)), 8);
+            ASSERT_LT(*std::max_element(std::begin(counts), std::end(counts)), 120);
+        }
+    }
+}
+
+GTEST_TEST(Shard, Partition)
+{ // each shard ends up in its own contiguous run.
+    RandomEngine      gen{};
+    std::vector<Uuid> samples(5000);
+    std::generate(std::begin(samples), std::end(samples), std::ref(gen));
+
+    auto       parted  = samples;
+    const auto offsets = partition(parted, 37);
+    ASSERT_EQ(std::size(offsets), 38);
+    ASSERT_EQ(offsets.front(), 0);
+    ASSERT_EQ(offsets.back(), std::size(samples));
+    for (std::uint32_t s = 0; s < 37; ++s)
+        for (auto i = offsets[s]; i < offsets[s + 1]; ++i)
+            ASSERT_EQ(shard(parted[i], 37), s);
+
+    std::sort(std::begin(samples), std::end(samples));
+    std::sort(std::begin(parted), std::end(parted));
+    ASSERT_EQ(parted, samples);
+
+    ASSERT_EQ(partition({}, 4), (std::vector<std::size_t>{ 0, 0, 0, 0, 0 }));
+    ASSERT_THROW((void)partition(parted, 0), std::invalid_argument);
+}